@@ -0,0 +1,105 @@
+#ifndef AGGREGATE_REFLECTION_CPP
+#define AGGREGATE_REFLECTION_CPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// --- Tier 0: Aggregate Reflection ---
+// Attributes are plain aggregates, so their fields can be enumerated without
+// any registration: FieldCount<T> counts the initializers T accepts, and
+// TieFields binds the fields by structured binding. Serialization reads the
+// field types to build schemas; the state hash reads them to prove a type has
+// no padding bytes.
+//
+// An empty base class (such as Attribute) takes an initializer but is not a
+// field, and each field is counted inside its own braces, so an array member
+// counts once rather than once per element.
+
+inline constexpr std::size_t MaxReflectedFields = 12;
+
+namespace ReflectionDetail {
+    // Stand-ins for aggregate initializers, only named in requires-clauses.
+    // AnyBase converts to a base class of T and nothing else.
+    template <typename T>
+    struct AnyBase {
+        template <typename U> requires (std::is_base_of_v<U, T> && !std::is_same_v<U, T>)
+        operator U() const;
+    };
+    struct AnyField {
+        template <typename U> operator U() const;
+    };
+
+    template <typename T, std::size_t... I>
+    constexpr bool TakesFields(std::index_sequence<I...>) {
+        if constexpr (requires { T{ AnyBase<T>{} }; }) return requires { T{ AnyBase<T>{}, { (void(I), AnyField{}) }... }; };
+        else return requires { T{ { (void(I), AnyField{}) }... }; };
+    }
+
+    // Stops one past MaxReflectedFields, so larger aggregates are reported
+    // rather than counted.
+    template <typename T, std::size_t N = 0>
+    constexpr std::size_t CountFields() {
+        if constexpr (N <= MaxReflectedFields && TakesFields<T>(std::make_index_sequence<N + 1>{})) return CountFields<T, N + 1>();
+        else return N;
+    }
+} // namespace ReflectionDetail
+
+template <typename T>
+inline constexpr std::size_t FieldCount = ReflectionDetail::CountFields<T>();
+
+// Whether TieFields accepts T.
+template <typename T>
+inline constexpr bool IsReflectable = std::is_aggregate_v<T> && FieldCount<T> > 0 && FieldCount<T> <= MaxReflectedFields;
+
+// A tuple of references to every field of an aggregate, in declaration order.
+template <typename T>
+constexpr auto TieFields(T& Value) {
+    constexpr std::size_t Count = FieldCount<std::remove_const_t<T>>;
+    static_assert(Count > 0 && Count <= MaxReflectedFields,
+        "Reflection Error: Attributes must be aggregates with 1 to MaxReflectedFields fields.");
+    if constexpr (Count == 1) { auto& [F0] = Value; return std::tie(F0); }
+    else if constexpr (Count == 2) { auto& [F0, F1] = Value; return std::tie(F0, F1); }
+    else if constexpr (Count == 3) { auto& [F0, F1, F2] = Value; return std::tie(F0, F1, F2); }
+    else if constexpr (Count == 4) { auto& [F0, F1, F2, F3] = Value; return std::tie(F0, F1, F2, F3); }
+    else if constexpr (Count == 5) { auto& [F0, F1, F2, F3, F4] = Value; return std::tie(F0, F1, F2, F3, F4); }
+    else if constexpr (Count == 6) { auto& [F0, F1, F2, F3, F4, F5] = Value; return std::tie(F0, F1, F2, F3, F4, F5); }
+    else if constexpr (Count == 7) { auto& [F0, F1, F2, F3, F4, F5, F6] = Value; return std::tie(F0, F1, F2, F3, F4, F5, F6); }
+    else if constexpr (Count == 8) { auto& [F0, F1, F2, F3, F4, F5, F6, F7] = Value; return std::tie(F0, F1, F2, F3, F4, F5, F6, F7); }
+    else if constexpr (Count == 9) { auto& [F0, F1, F2, F3, F4, F5, F6, F7, F8] = Value; return std::tie(F0, F1, F2, F3, F4, F5, F6, F7, F8); }
+    else if constexpr (Count == 10) { auto& [F0, F1, F2, F3, F4, F5, F6, F7, F8, F9] = Value; return std::tie(F0, F1, F2, F3, F4, F5, F6, F7, F8, F9); }
+    else if constexpr (Count == 11) { auto& [F0, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10] = Value; return std::tie(F0, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10); }
+    else { auto& [F0, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11] = Value; return std::tie(F0, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11); }
+}
+
+template <typename T, std::size_t Field>
+using FieldType = std::remove_cvref_t<std::tuple_element_t<Field, decltype(TieFields(std::declval<T&>()))>>;
+
+#ifdef AGGREGATE_REFLECTION_ENABLE_EXAMPLES
+
+#include <array>
+#include <cstdio>
+#include <string>
+
+struct Tagged {};
+struct Vector2 { float X, Y; };
+struct Sample : Tagged { Vector2 Position; float Weights[4]; std::array<int, 3> Ids; std::string Label; };
+struct Thirteen { int A, B, C, D, E, F, G, H, I, J, K, L, M; };
+
+static_assert(FieldCount<Vector2> == 2);
+static_assert(FieldCount<Sample> == 4, "The base is skipped and arrays count once.");
+static_assert(std::is_same_v<FieldType<Sample, 1>, float[4]> && std::is_same_v<FieldType<Sample, 3>, std::string>);
+static_assert(!IsReflectable<Thirteen> && !IsReflectable<int>);
+
+int main() {
+    Sample Value{ {}, { 1.0f, 2.0f }, { 0.5f }, { 7, 8, 9 }, "probe" };
+    std::get<0>(TieFields(Value)).Y = 3.0f;
+    const auto& [Position, Weights, Ids, Label] = TieFields(Value);
+    std::printf("%s at (%g, %g), weight %g, id %d\n", Label.c_str(), Position.X, Position.Y, Weights[0], Ids[2]);
+    return 0;
+}
+
+#endif // AGGREGATE_REFLECTION_ENABLE_EXAMPLES
+
+#endif // AGGREGATE_REFLECTION_CPP
@@ -0,0 +1,659 @@
+#ifndef ATTRIBUTE_SERIALIZATION_CPP
+#define ATTRIBUTE_SERIALIZATION_CPP
+
+#include "aggregate-reflection.cpp"
+#include "columnar-codec.cpp"
+#include "composition-pool.cpp"
+#include "type-ids.cpp"
+#include "world-state-hash.cpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// --- Tier 5: Schema-Versioned Attribute Serialization ---
+// Pools are saved column by column: for every Attribute, one contiguous array
+// per field across all instances. Each Attribute's record carries its schema
+// (name, version, field kinds) generated from aggregate reflection, so a
+// loader can tell an old layout apart from the current one.
+//
+// Old records are read into a ColumnSet and upgraded one version at a time by
+// AttributeMigration specializations, which edit whole field columns at once
+// (insert, remove, convert). Loading therefore stays a bulk columnar pass no
+// matter how old the data is. Records for Attributes the pool no longer has
+// are skipped, and Attributes missing from the file keep their defaults.
+//
+// Field columns go through the columnar codec (delta, run-length and byte
+// shuffle encodings), so files are typically several times smaller than the
+// pool in memory. Format version 1 files, with raw columns, still load.
+//
+// Data is written in host byte order; like the state hash, it assumes
+// little-endian peers.
+
+// --- Schemas ---
+enum class FieldKind : std::uint8_t {
+    Bool, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float32, Float64, String
+};
+
+template <typename F>
+constexpr FieldKind FieldKindOf() {
+    if constexpr (std::is_enum_v<F>) return FieldKindOf<std::underlying_type_t<F>>();
+    else if constexpr (std::is_same_v<F, bool>) return FieldKind::Bool;
+    else if constexpr (std::is_same_v<F, std::string>) return FieldKind::String;
+    else if constexpr (std::is_floating_point_v<F>) {
+        static_assert(sizeof(F) == 4 || sizeof(F) == 8, "Schema Error: Unsupported floating point field.");
+        return sizeof(F) == 4 ? FieldKind::Float32 : FieldKind::Float64;
+    } else {
+        static_assert(std::is_integral_v<F>, "Schema Error: Fields must be arithmetic, enums or std::string.");
+        constexpr FieldKind Signed[]   = { FieldKind::Int8, FieldKind::Int16, FieldKind::Int32, FieldKind::Int64 };
+        constexpr FieldKind Unsigned[] = { FieldKind::UInt8, FieldKind::UInt16, FieldKind::UInt32, FieldKind::UInt64 };
+        constexpr std::size_t Rank = sizeof(F) == 1 ? 0 : sizeof(F) == 2 ? 1 : sizeof(F) == 4 ? 2 : 3;
+        return std::is_signed_v<F> ? Signed[Rank] : Unsigned[Rank];
+    }
+}
+
+// Whether a byte read from a file names a FieldKind.
+constexpr bool IsFieldKind(std::uint8_t Value) { return Value <= static_cast<std::uint8_t>(FieldKind::String); }
+
+constexpr std::size_t FieldKindSize(FieldKind Kind) {
+    constexpr std::size_t Sizes[] = { 1, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8, 0 };
+    return Sizes[static_cast<std::size_t>(Kind)];
+}
+
+// An Attribute bumps SchemaVersion whenever its fields change, and may pin
+// SchemaName (see SchemaNameOf in type-ids.cpp) so it survives being renamed
+// or moved to another namespace.
+template <typename T>
+constexpr std::uint32_t SchemaVersionOf() {
+    if constexpr (requires { T::SchemaVersion; }) return T::SchemaVersion;
+    else return 1;
+}
+
+template <typename T, std::size_t... F>
+constexpr std::array<FieldKind, sizeof...(F)> FieldKindsOf(std::index_sequence<F...>) {
+    return { FieldKindOf<FieldType<T, F>>()... };
+}
+
+template <typename T>
+inline constexpr auto SchemaFields = FieldKindsOf<T>(std::make_index_sequence<FieldCount<T>>{});
+
+// --- Migration ---
+struct FieldColumn {
+    FieldKind Kind;
+    std::vector<std::byte> Bytes;      // Fixed-size kinds, Count * FieldKindSize(Kind).
+    std::vector<std::string> Strings;  // FieldKind::String.
+};
+
+// The fields of one Attribute column as stored on disk, in field order.
+class ColumnSet {
+public:
+    explicit ColumnSet(std::size_t InCount) : Count(InCount) {}
+
+    std::size_t Size() const { return Count; }
+    std::size_t FieldCount() const { return Fields.size(); }
+    FieldKind Kind(std::size_t Field) const { return Fields[Field].Kind; }
+
+    template <typename F>
+    std::span<F> Values(std::size_t Field) {
+        FieldColumn& Column = Fields[Field];
+        if constexpr (std::is_same_v<F, std::string>) {
+            return Column.Strings;
+        } else {
+            return { reinterpret_cast<F*>(Column.Bytes.data()), Count };
+        }
+    }
+
+    FieldColumn& AddColumn(FieldKind Kind) {
+        FieldColumn& Column = Fields.emplace_back();
+        Column.Kind = Kind;
+        if (Kind == FieldKind::String) Column.Strings.resize(Count);
+        else Column.Bytes.resize(Count * FieldKindSize(Kind));
+        return Column;
+    }
+
+    // --- Edits available to migrations ---
+    template <typename F>
+    void InsertField(std::size_t Field, const F& Default) {
+        FieldColumn Column;
+        Column.Kind = FieldKindOf<F>();
+        Fields.insert(Fields.begin() + Field, std::move(Column));
+        if constexpr (std::is_same_v<F, std::string>) {
+            Fields[Field].Strings.assign(Count, Default);
+        } else {
+            Fields[Field].Bytes.resize(Count * sizeof(F));
+            std::span<F> Filled = Values<F>(Field);
+            std::fill(Filled.begin(), Filled.end(), Default);
+        }
+    }
+
+    void RemoveField(std::size_t Field) { Fields.erase(Fields.begin() + Field); }
+
+    template <typename From, typename To>
+    void ConvertField(std::size_t Field) {
+        ColumnSet Converted(Count);
+        Converted.AddColumn(FieldKindOf<To>());
+        const std::span<From> Source = Values<From>(Field);
+        const std::span<To> Target = Converted.Values<To>(0);
+        for (std::size_t Index = 0; Index < Count; ++Index) Target[Index] = static_cast<To>(Source[Index]);
+        Fields[Field] = std::move(Converted.Fields[0]);
+    }
+
+private:
+    std::size_t Count;
+    std::vector<FieldColumn> Fields;
+};
+
+// Specialize with `static void Apply(ColumnSet&)` to upgrade an Attribute's
+// columns from FromVersion to FromVersion + 1.
+template <typename T, std::uint32_t FromVersion>
+struct AttributeMigration;
+
+template <typename T, std::uint32_t Version = 1>
+bool MigrateColumns(std::uint32_t FromVersion, ColumnSet& Columns) {
+    if constexpr (Version >= SchemaVersionOf<T>()) {
+        return true;
+    } else {
+        if (FromVersion <= Version) {
+            if constexpr (requires { AttributeMigration<T, Version>::Apply(Columns); }) {
+                AttributeMigration<T, Version>::Apply(Columns);
+            } else {
+                return false;
+            }
+        }
+        return MigrateColumns<T, Version + 1>(FromVersion, Columns);
+    }
+}
+
+// --- Pool Files ---
+namespace SerializationDetail {
+    inline constexpr std::uint32_t Magic = 0x56415343; // "CSAV"
+    inline constexpr std::uint32_t FormatVersion = 2;
+    inline constexpr std::uint32_t RawColumnsVersion = 1;
+
+    // Encoded columns can stand for far more values than they have bytes (a
+    // run of one value is 4 + Width bytes for up to 2^32 - 1 values), so
+    // ColumnFits() does not bound memory on its own. A file may hold at most
+    // MaxExpansion instances per byte, or MinimumInstanceLimit if that is more.
+    inline constexpr std::uint64_t MaxExpansion = 256;
+    inline constexpr std::uint64_t MinimumInstanceLimit = std::uint64_t(1) << 20;
+
+    inline bool InstanceCountFits(std::uint64_t InstanceCount, std::size_t ImageSize) {
+        return InstanceCount <= MinimumInstanceLimit || InstanceCount / MaxExpansion <= ImageSize;
+    }
+
+    struct FileHeader {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint32_t AttributeCount;
+        std::uint32_t Reserved;
+        std::uint64_t InstanceCount;
+    };
+
+    inline void AppendBytes(std::vector<std::byte>& Out, const void* Data, std::size_t Size) {
+        const std::byte* Bytes = static_cast<const std::byte*>(Data);
+        Out.insert(Out.end(), Bytes, Bytes + Size);
+    }
+
+    // Calls Visit(ChunkIndex, FirstSlot, RunLength) for every run of
+    // instances in [First, First + Count) that shares a chunk.
+    template <typename TPool, typename TVisit>
+    void ForEachRun(std::size_t First, std::size_t Count, TVisit&& Visit) {
+        while (Count > 0) {
+            const std::size_t ChunkIndex = First / TPool::Capacity, Slot = First % TPool::Capacity;
+            const std::size_t Run = std::min(Count, TPool::Capacity - Slot);
+            Visit(ChunkIndex, Slot, Run);
+            First += Run;
+            Count -= Run;
+        }
+    }
+
+    // Compresses one field column. Strings are a column of lengths followed by
+    // their bytes.
+    template <typename F>
+    void WriteFieldColumn(std::span<const F> Values, std::vector<std::byte>& Out) {
+        if constexpr (std::is_same_v<F, std::string>) {
+            std::vector<std::uint32_t> Lengths(Values.size());
+            for (std::size_t Index = 0; Index < Values.size(); ++Index) Lengths[Index] = static_cast<std::uint32_t>(Values[Index].size());
+            EncodeColumn(std::span<const std::uint32_t>(Lengths), Out);
+            for (const std::string& Value : Values) AppendBytes(Out, Value.data(), Value.size());
+        } else {
+            EncodeColumn(Values, Out);
+        }
+    }
+
+    template <typename TPool, typename T, std::size_t Field>
+    void GatherField(const TPool& Pool, std::vector<std::byte>& Out) {
+        using F = FieldType<T, Field>;
+        std::vector<F> Values;
+        Values.reserve(Pool.Size());
+        ForEachRun<TPool>(0, Pool.Size(), [&](std::size_t ChunkIndex, std::size_t Slot, std::size_t Run) {
+            const T* Column = Pool.template Column<T>(ChunkIndex);
+            for (std::size_t Offset = 0; Offset < Run; ++Offset) Values.push_back(std::get<Field>(TieFields(Column[Slot + Offset])));
+        });
+        WriteFieldColumn(std::span<const F>(Values), Out);
+    }
+
+    template <typename TPool, typename T, std::size_t Field>
+    void ScatterField(TPool& Pool, std::size_t First, ColumnSet& Columns) {
+        using F = FieldType<T, Field>;
+        const std::span<F> Values = Columns.Values<F>(Field);
+        std::size_t Next = 0;
+        ForEachRun<TPool>(First, Columns.Size(), [&](std::size_t ChunkIndex, std::size_t Slot, std::size_t Run) {
+            T* Column = Pool.template MutableColumn<T>(ChunkIndex);
+            for (std::size_t Offset = 0; Offset < Run; ++Offset) {
+                std::get<Field>(TieFields(Column[Slot + Offset])) = std::move(Values[Next++]);
+            }
+        });
+    }
+
+    template <typename TPool, typename T>
+    void WriteAttribute(const TPool& Pool, std::vector<std::byte>& Out) {
+        constexpr std::string_view Name = SchemaNameOf<T>();
+        constexpr auto& Kinds = SchemaFields<T>;
+        std::vector<std::byte> Payload;
+        [&]<std::size_t... F>(std::index_sequence<F...>) {
+            (GatherField<TPool, T, F>(Pool, Payload), ...);
+        }(std::make_index_sequence<FieldCount<T>>{});
+
+        const std::uint32_t NameLength = static_cast<std::uint32_t>(Name.size());
+        const std::uint32_t Version = SchemaVersionOf<T>();
+        const std::uint32_t Fields = static_cast<std::uint32_t>(Kinds.size());
+        const std::uint64_t PayloadSize = Payload.size();
+        AppendBytes(Out, &NameLength, sizeof(NameLength));
+        AppendBytes(Out, Name.data(), Name.size());
+        AppendBytes(Out, &Version, sizeof(Version));
+        AppendBytes(Out, &Fields, sizeof(Fields));
+        AppendBytes(Out, Kinds.data(), Kinds.size());
+        AppendBytes(Out, &PayloadSize, sizeof(PayloadSize));
+        Out.insert(Out.end(), Payload.begin(), Payload.end());
+    }
+
+    // A bounds-checked cursor over a file image already in memory.
+    class ByteReader {
+    public:
+        explicit ByteReader(std::span<const std::byte> InBytes) : Bytes(InBytes) {}
+
+        bool Read(void* Out, std::size_t Size) {
+            if (Size > Bytes.size() - Cursor) return false;
+            std::memcpy(Out, Bytes.data() + Cursor, Size);
+            Cursor += Size;
+            return true;
+        }
+        template <typename T>
+        bool Read(T& Out) { return Read(&Out, sizeof(T)); }
+
+        std::size_t Remaining() const { return Bytes.size() - Cursor; }
+        std::span<const std::byte> Unread() const { return Bytes.subspan(Cursor); }
+        std::size_t Position() const { return Cursor; }
+
+        bool Skip(std::uint64_t Size) {
+            if (Size > Bytes.size() - Cursor) return false;
+            Cursor += static_cast<std::size_t>(Size);
+            return true;
+        }
+
+    private:
+        std::span<const std::byte> Bytes;
+        std::size_t Cursor = 0;
+    };
+
+    // Compact per-instance encoding for packets and chunk records: fields in
+    // declaration order, strings as a 32-bit length followed by their bytes.
+    template <typename F>
+    void WriteValue(std::vector<std::byte>& Out, const F& Value) {
+        if constexpr (std::is_same_v<F, std::string>) {
+            const std::uint32_t Length = static_cast<std::uint32_t>(Value.size());
+            AppendBytes(Out, &Length, sizeof(Length));
+            AppendBytes(Out, Value.data(), Length);
+        } else {
+            AppendBytes(Out, &Value, sizeof(F));
+        }
+    }
+
+    template <typename F>
+    bool ReadValue(ByteReader& Reader, F& Value) {
+        if constexpr (std::is_same_v<F, std::string>) {
+            std::uint32_t Length = 0;
+            if (!Reader.Read(Length) || Length > Reader.Remaining()) return false;
+            Value.resize(Length);
+            return Reader.Read(Value.data(), Length);
+        } else {
+            return Reader.Read(Value);
+        }
+    }
+
+    template <typename T>
+    void WriteFields(std::vector<std::byte>& Out, const T& Value) {
+        std::apply([&](const auto&... Fields) { (WriteValue(Out, Fields), ...); }, TieFields(Value));
+    }
+
+    template <typename T>
+    bool ReadFields(ByteReader& Reader, T& Value) {
+        return std::apply([&](auto&... Fields) { return (ReadValue(Reader, Fields) && ...); }, TieFields(Value));
+    }
+
+    inline bool ReadEncoded(ByteReader& Reader, std::size_t Count, std::size_t Width, void* Out) {
+        const std::size_t Used = DecodeColumn(Reader.Unread(), Count, Width, Out);
+        return Used > 0 && Reader.Skip(Used);
+    }
+
+    // Whether the unread bytes can hold a column of Count values of Width
+    // bytes, encoded or raw. Checked before anything is sized from Count.
+    inline bool ColumnFits(const ByteReader& Reader, std::size_t Count, std::size_t Width, bool Encoded) {
+        return Encoded ? ::ColumnFits(Reader.Unread(), Count, Width) : Count <= Reader.Remaining() / Width;
+    }
+
+    // String bytes follow their lengths; all of them must be in the file
+    // before any string is allocated.
+    inline bool StringsFit(const ByteReader& Reader, std::span<const std::uint32_t> Lengths) {
+        std::uint64_t Total = 0;
+        for (const std::uint32_t Length : Lengths) Total += Length;
+        return Total <= Reader.Remaining();
+    }
+
+    template <typename F>
+    bool ReadFieldColumn(ByteReader& Reader, std::span<F> Values) {
+        if constexpr (std::is_same_v<F, std::string>) {
+            std::vector<std::uint32_t> Lengths(Values.size());
+            if (!ReadEncoded(Reader, Lengths.size(), sizeof(std::uint32_t), Lengths.data()) || !StringsFit(Reader, Lengths)) return false;
+            for (std::size_t Index = 0; Index < Values.size(); ++Index) {
+                Values[Index].resize(Lengths[Index]);
+                Reader.Read(Values[Index].data(), Lengths[Index]);
+            }
+            return true;
+        } else {
+            return ReadEncoded(Reader, Values.size(), sizeof(F), Values.data());
+        }
+    }
+
+    inline bool ReadColumns(ByteReader& Reader, const std::vector<FieldKind>& Kinds, bool Encoded, ColumnSet& Columns) {
+        for (const FieldKind Kind : Kinds) {
+            const std::size_t Width = Kind == FieldKind::String ? sizeof(std::uint32_t) : FieldKindSize(Kind);
+            if (!ColumnFits(Reader, Columns.Size(), Width, Encoded)) return false;
+            FieldColumn& Column = Columns.AddColumn(Kind);
+            if (Kind != FieldKind::String) {
+                const bool Read = Encoded ? ReadEncoded(Reader, Columns.Size(), Width, Column.Bytes.data())
+                                          : Reader.Read(Column.Bytes.data(), Column.Bytes.size());
+                if (!Read) return false;
+                continue;
+            }
+            std::vector<std::uint32_t> Lengths(Columns.Size());
+            const bool Read = Encoded ? ReadEncoded(Reader, Lengths.size(), Width, Lengths.data())
+                                      : Reader.Read(Lengths.data(), Lengths.size() * Width);
+            if (!Read || !StringsFit(Reader, Lengths)) return false;
+            for (std::size_t Index = 0; Index < Lengths.size(); ++Index) {
+                Column.Strings[Index].resize(Lengths[Index]);
+                Reader.Read(Column.Strings[Index].data(), Lengths[Index]);
+            }
+        }
+        return true;
+    }
+
+    inline bool ReadFile(const std::string& Path, std::vector<std::byte>& Out) {
+        std::FILE* File = std::fopen(Path.c_str(), "rb");
+        if (!File) return false;
+        bool Read = std::fseek(File, 0, SEEK_END) == 0;
+        const long Size = Read ? std::ftell(File) : -1;
+        Read = Size >= 0 && std::fseek(File, 0, SEEK_SET) == 0;
+        if (Read) {
+            Out.resize(static_cast<std::size_t>(Size));
+            Read = std::fread(Out.data(), 1, Out.size(), File) == Out.size();
+        }
+        std::fclose(File);
+        return Read;
+    }
+
+    // Upgrades Columns to T's current schema and checks that they match it.
+    template <typename T>
+    bool MigrateAttribute(std::uint32_t Version, ColumnSet& Columns) {
+        if (Version > SchemaVersionOf<T>() || !MigrateColumns<T>(Version, Columns)) return false;
+        constexpr auto& Kinds = SchemaFields<T>;
+        if (Columns.FieldCount() != Kinds.size()) return false;
+        for (std::size_t Field = 0; Field < Kinds.size(); ++Field) {
+            if (Columns.Kind(Field) != Kinds[Field]) return false;
+        }
+        return true;
+    }
+
+    template <typename TPool, typename T>
+    void ScatterAttribute(TPool& Pool, std::size_t First, ColumnSet& Columns) {
+        [&]<std::size_t... F>(std::index_sequence<F...>) {
+            (ScatterField<TPool, T, F>(Pool, First, Columns), ...);
+        }(std::make_index_sequence<FieldCount<T>>{});
+    }
+} // namespace SerializationDetail
+
+// Identifies a pool's on-disk layout: the Composition plus every Attribute's
+// schema name, version and field kinds. Caches and stores keyed by it are
+// invalidated by any schema change.
+template <typename TPool>
+std::uint64_t SchemaHashOf() {
+    StateHasher Hasher;
+    const std::string_view CompositionName = TypeName<typename TPool::CompositionType>();
+    Hasher.Append(CompositionName.data(), CompositionName.size());
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ([&] {
+            using T = typename TPool::template AttributeAt<I>;
+            constexpr std::string_view Name = SchemaNameOf<T>();
+            Hasher.Append(Name.data(), Name.size());
+            Hasher.AppendValue(SchemaVersionOf<T>());
+            Hasher.Append(SchemaFields<T>.data(), SchemaFields<T>.size());
+        }(), ...);
+    }(std::make_index_sequence<TPool::AttributeCount>{});
+    return Hasher.Finish();
+}
+
+template <typename TPool>
+bool SavePool(const TPool& Pool, const std::string& Path) {
+    using namespace SerializationDetail;
+    std::vector<std::byte> Out;
+    const FileHeader Header{ Magic, FormatVersion, static_cast<std::uint32_t>(TPool::AttributeCount), 0, Pool.Size() };
+    AppendBytes(Out, &Header, sizeof(Header));
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (WriteAttribute<TPool, typename TPool::template AttributeAt<I>>(Pool, Out), ...);
+    }(std::make_index_sequence<TPool::AttributeCount>{});
+
+    std::FILE* File = std::fopen(Path.c_str(), "wb");
+    if (!File) return false;
+    const bool Written = std::fwrite(Out.data(), 1, Out.size(), File) == Out.size();
+    return std::fclose(File) == 0 && Written;
+}
+
+// Whether LoadPool() runs OnCreate/OnEnable for the instances it adds. A
+// staging pool whose chunks move to a live pool skips them, and the live pool
+// runs them with RunSpawnHooks() after splicing.
+enum class LoadHooks { Run, Skip };
+
+// Appends the instances stored in a pool file image to Pool, migrating old
+// schemas. The whole image is parsed and validated into scratch columns
+// first: every count and length is checked against the bytes that remain
+// before anything is sized from it, and the instance count against the
+// image size. Only then are the instances added, so
+// on failure the pool is unchanged and no hooks have run. Hooks run once the
+// columns are filled, so they see the loaded values.
+template <typename TPool>
+bool LoadPool(TPool& Pool, std::span<const std::byte> Image, LoadHooks Hooks = LoadHooks::Run) {
+    using namespace SerializationDetail;
+    ByteReader Reader(Image);
+
+    FileHeader Header{};
+    bool Loaded = Reader.Read(Header) && Header.Magic == Magic
+        && (Header.Version == FormatVersion || Header.Version == RawColumnsVersion)
+        && (Header.AttributeCount > 0 || Header.InstanceCount == 0)
+        && InstanceCountFits(Header.InstanceCount, Image.size());
+    const bool Encoded = Header.Version != RawColumnsVersion;
+    std::vector<std::unique_ptr<ColumnSet>> Parsed(TPool::AttributeCount);
+
+    for (std::uint32_t Record = 0; Loaded && Record < Header.AttributeCount; ++Record) {
+        std::uint32_t NameLength = 0, Version = 0, Fields = 0;
+        std::uint64_t PayloadSize = 0;
+        std::string Name;
+        std::vector<FieldKind> Kinds;
+        Loaded = Reader.Read(NameLength) && NameLength <= Reader.Remaining();
+        if (Loaded) {
+            Name.resize(NameLength);
+            Loaded = Reader.Read(Name.data(), NameLength) && Reader.Read(Version) && Reader.Read(Fields)
+                && Fields > 0 && Fields <= Reader.Remaining();
+        }
+        if (Loaded) {
+            Kinds.resize(Fields);
+            Loaded = Reader.Read(Kinds.data(), Fields) && Reader.Read(PayloadSize) && PayloadSize <= Reader.Remaining();
+            for (const FieldKind Kind : Kinds) Loaded = Loaded && IsFieldKind(static_cast<std::uint8_t>(Kind));
+        }
+        if (!Loaded) break;
+        // Each record is parsed within its own payload, which a known
+        // Attribute must consume exactly, so a wrong PayloadSize cannot put
+        // the records after it out of step.
+        ByteReader Payload(Reader.Unread().first(static_cast<std::size_t>(PayloadSize)));
+        Reader.Skip(PayloadSize);
+        // Every record's first column vouches for the instance count, known
+        // Attribute or not.
+        const std::size_t FirstWidth = Kinds[0] != FieldKind::String ? FieldKindSize(Kinds[0]) : sizeof(std::uint32_t);
+        Loaded = ColumnFits(Payload, Header.InstanceCount, FirstWidth, Encoded);
+        if (!Loaded) break;
+
+        bool Known = false;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ([&] {
+                using T = typename TPool::template AttributeAt<I>;
+                if (Known || Name != SchemaNameOf<T>()) return;
+                Known = true;
+                auto Columns = std::make_unique<ColumnSet>(Header.InstanceCount);
+                Loaded = !Parsed[I] && ReadColumns(Payload, Kinds, Encoded, *Columns) && Payload.Remaining() == 0
+                    && MigrateAttribute<T>(Version, *Columns);
+                Parsed[I] = std::move(Columns);
+            }(), ...);
+        }(std::make_index_sequence<TPool::AttributeCount>{});
+    }
+    if (!Loaded) return false;
+
+    const std::size_t First = Pool.AllocateDefault(Header.InstanceCount);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((Parsed[I] ? ScatterAttribute<TPool, typename TPool::template AttributeAt<I>>(Pool, First, *Parsed[I]) : void()), ...);
+    }(std::make_index_sequence<TPool::AttributeCount>{});
+    if (Hooks == LoadHooks::Run) Pool.RunSpawnHooks(First, Header.InstanceCount);
+    return true;
+}
+
+template <typename TPool>
+bool LoadPool(TPool& Pool, const std::string& Path, LoadHooks Hooks = LoadHooks::Run) {
+    std::vector<std::byte> Image;
+    return SerializationDetail::ReadFile(Path, Image) && LoadPool(Pool, std::span<const std::byte>(Image), Hooks);
+}
+
+// --- EXAMPLE USAGE ---
+#ifdef SERIALIZATION_ENABLE_EXAMPLES
+
+#include <cstddef>
+#include <filesystem>
+
+// What shipped last year: a 2D position.
+namespace Legacy {
+    struct Transform : public Attribute {
+        static constexpr const char* SchemaName = "Transform";
+        float X = 0.0f, Y = 0.0f;
+    };
+    struct Category : public Attribute {
+        static constexpr const char* SchemaName = "Category";
+        std::string Name = "Default";
+    };
+    class Player : public Composition<Player, TypeList<>, TypeList<Transform, Category>> {};
+}
+
+// The current layout: Z was added in version 2 and Scale in version 3.
+struct Transform : public Attribute {
+    static constexpr const char* SchemaName = "Transform";
+    static constexpr std::uint32_t SchemaVersion = 3;
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+    float Scale = 1.0f;
+};
+struct Category : public Attribute {
+    static constexpr const char* SchemaName = "Category";
+    std::string Name = "Default";
+};
+
+template <>
+struct AttributeMigration<Transform, 1> {
+    static void Apply(ColumnSet& Columns) { Columns.InsertField<float>(2, 0.0f); }
+};
+template <>
+struct AttributeMigration<Transform, 2> {
+    static void Apply(ColumnSet& Columns) { Columns.InsertField<float>(3, 1.0f); }
+};
+
+class Player : public Composition<Player, TypeList<>, TypeList<Transform, Category>> {};
+
+int main() {
+    const std::string Path = (std::filesystem::temp_directory_path() / "composition-legacy.save").string();
+    {
+        CompositionPool<Legacy::Player> OldSave;
+        for (int Index = 0; Index < 1000; ++Index) {
+            OldSave.Spawn(Legacy::Transform{{}, float(Index), float(-Index)}, Legacy::Category{{}, "Player" + std::to_string(Index)});
+        }
+        SavePool(OldSave, Path);
+    }
+
+    CompositionPool<Player> Pool;
+    const bool Loaded = LoadPool(Pool, Path);
+    const Transform& Last = Pool.Attribute<Transform>(Pool.Size() - 1);
+    std::cout << "Loaded " << Pool.Size() << " players from schema v1: " << (Loaded ? "ok" : "failed") << "\n"
+              << Pool.Attribute<Category>(Pool.Size() - 1).Name << " at (" << Last.X << ", " << Last.Y << ", " << Last.Z
+              << ") scale " << Last.Scale << "\n";
+
+    // Damaged files fail without touching the pool: a field kind byte out of
+    // range, an instance count far beyond the file, a record whose payload
+    // size does not match its columns, a truncated file, and 2 KB of
+    // run-length runs claiming 2^40 instances.
+    std::vector<std::byte> Image;
+    SerializationDetail::ReadFile(Path, Image);
+    const std::size_t KindOffset = sizeof(SerializationDetail::FileHeader) + sizeof(std::uint32_t) + 9 + 2 * sizeof(std::uint32_t);
+    std::vector<std::byte> BadKind = Image, HugeCount = Image, LongPayload = Image, Truncated(Image.begin(), Image.end() - 100);
+    BadKind[KindOffset] = std::byte{ 0xFF };
+    std::uint64_t PayloadSize = 0;
+    std::memcpy(&PayloadSize, LongPayload.data() + KindOffset + 2, sizeof(PayloadSize));
+    ++PayloadSize;
+    std::memcpy(LongPayload.data() + KindOffset + 2, &PayloadSize, sizeof(PayloadSize));
+    const std::uint64_t Huge = std::uint64_t(1) << 40;
+    std::memcpy(HugeCount.data() + offsetof(SerializationDetail::FileHeader, InstanceCount), &Huge, sizeof(Huge));
+    std::vector<std::byte> Amplified;
+    {
+        using namespace SerializationDetail;
+        const FileHeader Header{ Magic, FormatVersion, 1, 0, Huge };
+        const std::string_view Name = "Transform";
+        const std::uint32_t NameLength = std::uint32_t(Name.size()), Version = 3, Fields = 4;
+        const FieldKind Kinds[4] = { FieldKind::Float32, FieldKind::Float32, FieldKind::Float32, FieldKind::Float32 };
+        std::vector<std::byte> Column{ std::byte(ColumnEncoding::RunLength) };
+        for (int Run = 0; Run < 257; ++Run) {
+            const std::uint32_t Length = 0xFFFFFFFFu;
+            const float Value = 0.0f;
+            AppendBytes(Column, &Length, sizeof(Length));
+            AppendBytes(Column, &Value, sizeof(Value));
+        }
+        const std::uint64_t ColumnSize = Column.size();
+        AppendBytes(Amplified, &Header, sizeof(Header));
+        AppendBytes(Amplified, &NameLength, sizeof(NameLength));
+        AppendBytes(Amplified, Name.data(), Name.size());
+        AppendBytes(Amplified, &Version, sizeof(Version));
+        AppendBytes(Amplified, &Fields, sizeof(Fields));
+        AppendBytes(Amplified, Kinds, sizeof(Kinds));
+        AppendBytes(Amplified, &ColumnSize, sizeof(ColumnSize));
+        AppendBytes(Amplified, Column.data(), Column.size());
+    }
+    const std::size_t Before = Pool.Size();
+    const bool Rejected = !LoadPool(Pool, std::span<const std::byte>(BadKind)) && !LoadPool(Pool, std::span<const std::byte>(HugeCount))
+                       && !LoadPool(Pool, std::span<const std::byte>(LongPayload)) && !LoadPool(Pool, std::span<const std::byte>(Truncated))
+                       && !LoadPool(Pool, std::span<const std::byte>(Amplified))
+                       && Pool.Size() == Before;
+    std::cout << "Damaged files rejected with the pool unchanged: " << (Rejected ? "yes" : "no") << std::endl;
+    std::filesystem::remove(Path);
+    return 0;
+}
+
+#endif // SERIALIZATION_ENABLE_EXAMPLES
+
+#endif // ATTRIBUTE_SERIALIZATION_CPP
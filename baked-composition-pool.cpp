@@ -0,0 +1,179 @@
+#ifndef BAKED_COMPOSITION_POOL_CPP
+#define BAKED_COMPOSITION_POOL_CPP
+
+#include "composition-pool.cpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// --- Tier 4: Compile-Time Baked Pools ---
+// Static level content (props, spawn points, lookup tables) never changes
+// after it is authored. BakePool() evaluates the Compositions of such content
+// at compile time and stores their Attributes column by column, like a
+// CompositionPool. Declared `static constexpr`, the result is an initialized
+// constant in .rodata: there is no constructor to run at startup, the pages
+// are loaded on first touch, and every process running the same binary
+// shares them through the page cache.
+//
+// Only trivially copyable, trivially destructible Attributes can be baked,
+// and the Composition must be constructible in a constant expression (e.g.
+// through the constexpr piecewise constructor). Roles are not stored, as in a
+// CompositionPool. BakedPool offers the read side of the pool interface, so
+// code templated on a pool can read baked content directly; SpawnInto() copies
+// it into a live pool when instances must become mutable.
+
+namespace BakedDetail {
+    template <typename T, std::size_t Count>
+    struct Column {
+        std::array<T, Count> Values{};
+    };
+} // namespace BakedDetail
+
+template <typename TComposition, std::size_t Count, std::size_t ChunkCapacity = 256,
+          typename AttributesList = typename TComposition::AttributesList>
+class BakedPool;
+
+template <typename TComposition, std::size_t Count, std::size_t ChunkCapacity, typename... TAttributes>
+class BakedPool<TComposition, Count, ChunkCapacity, TypeList<TAttributes...>> : private BakedDetail::Column<TAttributes, Count>... {
+public:
+    using CompositionType = TComposition;
+
+    static constexpr std::size_t Capacity       = ChunkCapacity;
+    static constexpr std::size_t AttributeCount = sizeof...(TAttributes);
+
+    static_assert(Count > 0, "BakedPool Error: A baked pool needs at least one instance.");
+    static_assert(((std::is_trivially_copyable_v<TAttributes> && std::is_trivially_destructible_v<TAttributes>) && ...),
+        "BakedPool Error: Only trivially copyable, trivially destructible Attributes can be baked into read-only data.");
+
+    // Evaluates Make(Index) for every instance. Used through BakePool().
+    template <typename TMake>
+    constexpr explicit BakedPool(TMake&& Make) {
+        for (std::size_t Index = 0; Index < Count; ++Index) {
+            const TComposition Instance = Make(Index);
+            ((Values<TAttributes>()[Index] = Instance.template Attribute<TAttributes>()), ...);
+        }
+    }
+
+    // --- Instances ---
+    static constexpr std::size_t Size() { return Count; }
+
+    template <typename T>
+    constexpr const T& Attribute(std::size_t Index) const { return Values<T>()[Index]; }
+
+    // The whole column of T, for loops that do not need chunks.
+    template <typename T>
+    constexpr std::span<const T, Count> Column() const { return Values<T>(); }
+
+    // --- Chunks ---
+    static constexpr std::size_t ChunkCount() { return (Count + ChunkCapacity - 1) / ChunkCapacity; }
+    static constexpr std::uint32_t ChunkSize(std::size_t ChunkIndex) {
+        return static_cast<std::uint32_t>(ChunkIndex + 1 < ChunkCount() ? ChunkCapacity : Count - ChunkIndex * ChunkCapacity);
+    }
+
+    template <typename T>
+    constexpr const T* Column(std::size_t ChunkIndex) const { return Values<T>().data() + ChunkIndex * ChunkCapacity; }
+
+    // Copies every instance into Pool and returns the index of the first.
+    // OnCreate and OnEnable run after the copy, so hooks see baked values.
+    template <typename TPool>
+    std::size_t SpawnInto(TPool& Pool) const {
+        static_assert(std::is_same_v<typename TPool::CompositionType, TComposition>, "BakedPool Error: The pool holds a different Composition.");
+        const std::size_t First = Pool.AllocateDefault(Count);
+        for (std::size_t Index = 0; Index < Count; ++Index) {
+            ((Pool.template Attribute<TAttributes>(First + Index) = Values<TAttributes>()[Index]), ...);
+        }
+        Pool.RunSpawnHooks(First, Count);
+        return First;
+    }
+
+private:
+    template <typename T>
+    constexpr std::array<T, Count>& Values() {
+        static_assert(Contains<TypeList<TAttributes...>, T>, "Attempted to access an Attribute that is not pooled.");
+        return static_cast<BakedDetail::Column<T, Count>&>(*this).Values;
+    }
+    template <typename T>
+    constexpr const std::array<T, Count>& Values() const {
+        static_assert(Contains<TypeList<TAttributes...>, T>, "Attempted to access an Attribute that is not pooled.");
+        return static_cast<const BakedDetail::Column<T, Count>&>(*this).Values;
+    }
+};
+
+// Bakes Count instances, Make(Index) returning each one. Use as
+//     static constexpr auto Props = BakePool<Prop, 4096>([](std::size_t Index) { return Prop(...); });
+template <typename TComposition, std::size_t Count, std::size_t ChunkCapacity = 256, typename TMake>
+constexpr BakedPool<TComposition, Count, ChunkCapacity> BakePool(TMake&& Make) {
+    return BakedPool<TComposition, Count, ChunkCapacity>(Make);
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef BAKED_POOL_ENABLE_EXAMPLES
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+struct Transform : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Collision : public Attribute {
+    float Radius = 1.0f;
+    std::uint32_t Layer = 0;
+};
+
+class Prop : public Composition<Prop, TypeList<>, TypeList<Transform, Collision>> {
+public:
+    using Composition::Composition;
+};
+
+// The harbour's crates and bollards, laid out on a grid when the game is compiled.
+static constexpr auto Harbour = BakePool<Prop, 4096>([](std::size_t Index) {
+    const bool Bollard = Index % 8 == 0;
+    return Prop(std::piecewise_construct,
+                InPlace<Transform>(float(Index % 64) * 2.0f, 0.0f, float(Index / 64) * 2.0f),
+                InPlace<Collision>(Bollard ? 0.25f : 0.75f, Bollard ? 2u : 1u));
+});
+
+static_assert(Harbour.Attribute<Transform>(65).Z == 2.0f, "Baked values are usable in constant expressions.");
+static_assert(Harbour.ChunkCount() == 16 && Harbour.ChunkSize(15) == 256);
+
+// Reports the permissions of the mapping that holds Address.
+static std::string MappingOf(const void* Address) {
+    std::ifstream Maps("/proc/self/maps");
+    const auto Target = reinterpret_cast<std::uintptr_t>(Address);
+    for (std::string Line; std::getline(Maps, Line);) {
+        std::istringstream Fields(Line);
+        std::string Range, Permissions;
+        Fields >> Range >> Permissions;
+        const std::size_t Dash = Range.find('-');
+        if (Dash == std::string::npos) continue;
+        const std::uintptr_t Begin = std::stoull(Range.substr(0, Dash), nullptr, 16), End = std::stoull(Range.substr(Dash + 1), nullptr, 16);
+        if (Target >= Begin && Target < End) return Permissions;
+    }
+    return "unknown";
+}
+
+int main() {
+    float Blocking = 0.0f;
+    for (std::size_t ChunkIndex = 0; ChunkIndex < Harbour.ChunkCount(); ++ChunkIndex) {
+        const Collision* Shapes = Harbour.Column<Collision>(ChunkIndex);
+        for (std::uint32_t Slot = 0; Slot < Harbour.ChunkSize(ChunkIndex); ++Slot) Blocking += Shapes[Slot].Radius;
+    }
+    std::cout << Harbour.Size() << " props, " << sizeof(Harbour) << " bytes in a mapping with permissions "
+              << MappingOf(&Harbour) << ", total collision radius " << Blocking << "\n";
+
+    // Props that gameplay may move get copied into a live pool.
+    CompositionPool<Prop> Live;
+    const std::size_t First = Harbour.SpawnInto(Live);
+    Live.Attribute<Transform>(First + 1).Y += 1.0f;
+    std::cout << "Copied " << Live.Size() << " into a live pool, prop 1 lifted to Y=" << Live.Attribute<Transform>(First + 1).Y << std::endl;
+    return 0;
+}
+
+#endif // BAKED_POOL_ENABLE_EXAMPLES
+
+#endif // BAKED_COMPOSITION_POOL_CPP
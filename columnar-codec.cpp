@@ -0,0 +1,439 @@
+#ifndef COLUMNAR_CODEC_CPP
+#define COLUMNAR_CODEC_CPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// --- Tier 4: Columnar Compression ---
+// Saves and checkpoints store Attributes field by field, and those columns
+// compress well with simple, branch-light transforms. Each column is encoded
+// with whichever of these is smallest:
+//
+// - Raw: the values as they are.
+// - RunLength: (length, value) pairs, for tags and flags that rarely change.
+// - DeltaBitPack: integers as zigzagged deltas of their neighbour, packed in
+//   blocks of 128 with a per-block bit width. Ids and counters shrink to a few
+//   bits per value.
+// - ByteShuffle: floats XORed with their neighbour, split into byte planes,
+//   with each plane stored raw or run-length encoded. Nearby values share sign,
+//   exponent and high mantissa bits, so the upper planes collapse into a few
+//   runs.
+//
+// Decoding needs no allocation besides plane scratch and is built from fixed
+// width loops the compiler can unroll and vectorize. The encoded form is
+// little-endian and only self-describing up to the encoding tag: the reader
+// must know the value count and width.
+
+enum class ColumnEncoding : std::uint8_t { Raw, RunLength, DeltaBitPack, ByteShuffle };
+
+namespace ColumnCodecDetail {
+    inline constexpr std::size_t BlockSize = 128;
+    inline constexpr std::size_t Padding = 8; // Lets unpacking read whole words past the last block.
+
+    template <typename U>
+    inline constexpr unsigned BitsOf = sizeof(U) * 8;
+
+    inline std::uint64_t LoadWord(const std::byte* At) {
+        std::uint64_t Word;
+        std::memcpy(&Word, At, sizeof(Word));
+        return Word;
+    }
+
+    inline void AppendBytes(std::vector<std::byte>& Out, const void* Data, std::size_t Size) {
+        const std::byte* Bytes = static_cast<const std::byte*>(Data);
+        Out.insert(Out.end(), Bytes, Bytes + Size);
+    }
+
+    template <typename U>
+    U ZigZag(U Delta) {
+        using S = std::make_signed_t<U>;
+        return static_cast<U>(static_cast<U>(Delta << 1) ^ static_cast<U>(static_cast<S>(Delta) >> (BitsOf<U> - 1)));
+    }
+
+    template <typename U>
+    U UnZigZag(U Value) {
+        return static_cast<U>((Value >> 1) ^ static_cast<U>(0 - (Value & 1)));
+    }
+
+    // --- Run length ---
+    // Gives up (returns false) as soon as the output would exceed Limit bytes.
+    template <typename U>
+    bool EncodeRuns(const U* Values, std::size_t Count, std::size_t Limit, std::vector<std::byte>& Out) {
+        const std::size_t Start = Out.size();
+        for (std::size_t Index = 0; Index < Count;) {
+            std::size_t End = Index + 1;
+            while (End < Count && End - Index < UINT32_MAX && Values[End] == Values[Index]) ++End;
+            const std::uint32_t Length = static_cast<std::uint32_t>(End - Index);
+            AppendBytes(Out, &Length, sizeof(Length));
+            AppendBytes(Out, &Values[Index], sizeof(U));
+            if (Out.size() - Start > Limit) return false;
+            Index = End;
+        }
+        return true;
+    }
+
+    template <typename U>
+    std::size_t DecodeRuns(std::span<const std::byte> In, std::size_t Count, U* Out) {
+        std::size_t Cursor = 0;
+        for (std::size_t Filled = 0; Filled < Count;) {
+            if (In.size() - Cursor < sizeof(std::uint32_t) + sizeof(U)) return 0;
+            std::uint32_t Length;
+            U Value;
+            std::memcpy(&Length, In.data() + Cursor, sizeof(Length));
+            std::memcpy(&Value, In.data() + Cursor + sizeof(Length), sizeof(U));
+            Cursor += sizeof(Length) + sizeof(U);
+            if (Length == 0 || Length > Count - Filled) return 0;
+            std::fill_n(Out + Filled, Length, Value);
+            Filled += Length;
+        }
+        return Cursor;
+    }
+
+    // --- Delta + zigzag + bit packing ---
+    // Value I of a block occupies bits [I * Bits, (I + 1) * Bits) of the block,
+    // so every group of eight values starts on a byte boundary and the offsets
+    // inside a group are compile-time constants.
+    template <typename U, unsigned Bits>
+    void UnpackBlock(const std::byte* In, U* Out) {
+        if constexpr (Bits == 0) {
+            std::fill_n(Out, BlockSize, U(0));
+        } else {
+            constexpr std::uint64_t Mask = Bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << Bits) - 1;
+            for (std::size_t Group = 0; Group < BlockSize / 8; ++Group, In += Bits, Out += 8) {
+                [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+                    ([&] {
+                        constexpr std::size_t Bit = Index * Bits, Shift = Bit % 8;
+                        std::uint64_t Word = LoadWord(In + Bit / 8) >> Shift;
+                        if constexpr (Shift + Bits > 64) Word |= LoadWord(In + Bit / 8 + 8) << (64 - Shift);
+                        Out[Index] = static_cast<U>(Word & Mask);
+                    }(), ...);
+                }(std::make_index_sequence<8>{});
+            }
+        }
+    }
+
+    template <typename U>
+    using UnpackFunction = void (*)(const std::byte*, U*);
+
+    template <typename U, std::size_t... Bits>
+    constexpr std::array<UnpackFunction<U>, sizeof...(Bits)> MakeUnpackTable(std::index_sequence<Bits...>) {
+        return { &UnpackBlock<U, Bits>... };
+    }
+
+    template <typename U>
+    inline constexpr auto UnpackTable = MakeUnpackTable<U>(std::make_index_sequence<BitsOf<U> + 1>{});
+
+    template <typename U>
+    void EncodeDeltas(const U* Values, std::size_t Count, std::vector<std::byte>& Out) {
+        std::byte Packed[BlockSize * 8 + 16];
+        U Previous = 0;
+        for (std::size_t First = 0; First < Count; First += BlockSize) {
+            const std::size_t Length = std::min(BlockSize, Count - First);
+            U Zigzags[BlockSize] = {};
+            U Combined = 0;
+            for (std::size_t Index = 0; Index < Length; ++Index) {
+                Zigzags[Index] = ZigZag(static_cast<U>(Values[First + Index] - Previous));
+                Previous = Values[First + Index];
+                Combined |= Zigzags[Index];
+            }
+            std::uint8_t Bits = 0;
+            while (Bits < BitsOf<U> && (static_cast<std::uint64_t>(Combined) >> Bits) != 0) ++Bits;
+
+            std::memset(Packed, 0, sizeof(Packed));
+            for (std::size_t Index = 0; Index < Length && Bits > 0; ++Index) {
+                const std::size_t Bit = Index * Bits, Shift = Bit % 8;
+                const std::uint64_t Value = Zigzags[Index];
+                std::uint64_t Word = LoadWord(Packed + Bit / 8) | (Value << Shift);
+                std::memcpy(Packed + Bit / 8, &Word, sizeof(Word));
+                if (Shift + Bits > 64) {
+                    Word = LoadWord(Packed + Bit / 8 + 8) | (Value >> (64 - Shift));
+                    std::memcpy(Packed + Bit / 8 + 8, &Word, sizeof(Word));
+                }
+            }
+            Out.push_back(static_cast<std::byte>(Bits));
+            AppendBytes(Out, Packed, BlockSize / 8 * Bits);
+        }
+        Out.insert(Out.end(), Padding, std::byte{ 0 });
+    }
+
+    template <typename U>
+    std::size_t DecodeDeltas(std::span<const std::byte> In, std::size_t Count, U* Out) {
+        std::size_t Cursor = 0;
+        U Previous = 0;
+        for (std::size_t First = 0; First < Count; First += BlockSize) {
+            if (Cursor >= In.size()) return 0;
+            const unsigned Bits = static_cast<unsigned>(In[Cursor++]);
+            if (Bits > BitsOf<U> || In.size() - Cursor < BlockSize / 8 * Bits + Padding) return 0;
+            U Zigzags[BlockSize];
+            UnpackTable<U>[Bits](In.data() + Cursor, Zigzags);
+            Cursor += BlockSize / 8 * Bits;
+
+            for (U& Value : Zigzags) Value = UnZigZag(Value);
+            const std::size_t Length = std::min(BlockSize, Count - First);
+            for (std::size_t Index = 0; Index < Length; ++Index) {
+                Previous = static_cast<U>(Previous + Zigzags[Index]);
+                Out[First + Index] = Previous;
+            }
+        }
+        return In.size() - Cursor < Padding ? 0 : Cursor + Padding;
+    }
+
+    // --- XOR + byte shuffle ---
+    template <typename U>
+    void EncodeShuffled(const U* Values, std::size_t Count, std::vector<std::byte>& Out) {
+        std::vector<std::uint8_t> Planes(Count * sizeof(U));
+        U Previous = 0;
+        for (std::size_t Index = 0; Index < Count; ++Index) {
+            const U Xored = static_cast<U>(Values[Index] ^ Previous);
+            Previous = Values[Index];
+            for (std::size_t Plane = 0; Plane < sizeof(U); ++Plane) {
+                Planes[Plane * Count + Index] = static_cast<std::uint8_t>(Xored >> (Plane * 8));
+            }
+        }
+        for (std::size_t Plane = 0; Plane < sizeof(U); ++Plane) {
+            const std::uint8_t* Bytes = Planes.data() + Plane * Count;
+            const std::size_t Tag = Out.size();
+            Out.push_back(static_cast<std::byte>(ColumnEncoding::RunLength));
+            if (!EncodeRuns(Bytes, Count, Count / 4, Out)) {
+                Out.resize(Tag);
+                Out.push_back(static_cast<std::byte>(ColumnEncoding::Raw));
+                AppendBytes(Out, Bytes, Count);
+            }
+        }
+    }
+
+    template <typename U>
+    std::size_t DecodeShuffled(std::span<const std::byte> In, std::size_t Count, U* Out) {
+        thread_local std::vector<std::uint8_t> Planes;
+        Planes.resize(Count * sizeof(U));
+        std::size_t Cursor = 0;
+        for (std::size_t Plane = 0; Plane < sizeof(U); ++Plane) {
+            if (Cursor >= In.size()) return 0;
+            const ColumnEncoding Encoding = static_cast<ColumnEncoding>(In[Cursor++]);
+            std::uint8_t* Bytes = Planes.data() + Plane * Count;
+            if (Encoding == ColumnEncoding::Raw) {
+                if (In.size() - Cursor < Count) return 0;
+                std::memcpy(Bytes, In.data() + Cursor, Count);
+                Cursor += Count;
+            } else {
+                const std::size_t Used = Encoding == ColumnEncoding::RunLength ? DecodeRuns(In.subspan(Cursor), Count, Bytes) : 0;
+                if (Used == 0 && Count > 0) return 0;
+                Cursor += Used;
+            }
+        }
+        // Interleaves through a local block so the plane loops do not alias Out.
+        U Previous = 0;
+        for (std::size_t First = 0; First < Count; First += BlockSize) {
+            const std::size_t Length = std::min(BlockSize, Count - First);
+            U Xored[BlockSize] = {};
+            std::size_t Interleaved = 0;
+#if defined(__SSE2__)
+            if constexpr (sizeof(U) == 4) {
+                const std::uint8_t* Bytes = Planes.data() + First;
+                for (; Interleaved + 16 <= Length; Interleaved += 16) {
+                    const auto Load = [&](std::size_t Plane) {
+                        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Bytes + Plane * Count + Interleaved));
+                    };
+                    const __m128i Low01 = _mm_unpacklo_epi8(Load(0), Load(1)), High01 = _mm_unpackhi_epi8(Load(0), Load(1));
+                    const __m128i Low23 = _mm_unpacklo_epi8(Load(2), Load(3)), High23 = _mm_unpackhi_epi8(Load(2), Load(3));
+                    __m128i* Target = reinterpret_cast<__m128i*>(Xored + Interleaved);
+                    _mm_storeu_si128(Target + 0, _mm_unpacklo_epi16(Low01, Low23));
+                    _mm_storeu_si128(Target + 1, _mm_unpackhi_epi16(Low01, Low23));
+                    _mm_storeu_si128(Target + 2, _mm_unpacklo_epi16(High01, High23));
+                    _mm_storeu_si128(Target + 3, _mm_unpackhi_epi16(High01, High23));
+                }
+            }
+#endif
+            for (std::size_t Plane = 0; Plane < sizeof(U) && Interleaved < Length; ++Plane) {
+                const std::uint8_t* Bytes = Planes.data() + Plane * Count + First;
+                for (std::size_t Index = Interleaved; Index < Length; ++Index) Xored[Index] |= static_cast<U>(static_cast<U>(Bytes[Index]) << (Plane * 8));
+            }
+            for (std::size_t Index = 0; Index < Length; ++Index) Out[First + Index] = Previous ^= Xored[Index];
+        }
+        return Cursor;
+    }
+
+    template <typename U>
+    void Encode(const U* Values, std::size_t Count, bool IsFloat, std::vector<std::byte>& Out) {
+        const std::size_t RawSize = Count * sizeof(U);
+        std::vector<std::byte> Best, Candidate;
+        Best.push_back(static_cast<std::byte>(ColumnEncoding::Raw));
+        AppendBytes(Best, Values, RawSize);
+
+        Candidate.push_back(static_cast<std::byte>(ColumnEncoding::RunLength));
+        if (EncodeRuns(Values, Count, RawSize, Candidate) && Candidate.size() < Best.size()) std::swap(Best, Candidate);
+
+        Candidate.clear();
+        if (IsFloat) {
+            Candidate.push_back(static_cast<std::byte>(ColumnEncoding::ByteShuffle));
+            EncodeShuffled(Values, Count, Candidate);
+        } else {
+            Candidate.push_back(static_cast<std::byte>(ColumnEncoding::DeltaBitPack));
+            EncodeDeltas(Values, Count, Candidate);
+        }
+        if (Candidate.size() < Best.size()) std::swap(Best, Candidate);
+        Out.insert(Out.end(), Best.begin(), Best.end());
+    }
+
+    template <typename U>
+    std::size_t Decode(std::span<const std::byte> In, std::size_t Count, U* Out) {
+        if (In.empty()) return 0;
+        const std::span<const std::byte> Payload = In.subspan(1);
+        std::size_t Used = 0;
+        switch (static_cast<ColumnEncoding>(In[0])) {
+        case ColumnEncoding::Raw:
+            if (Payload.size() < Count * sizeof(U)) return 0;
+            std::memcpy(Out, Payload.data(), Count * sizeof(U));
+            Used = Count * sizeof(U);
+            break;
+        case ColumnEncoding::RunLength:
+            Used = DecodeRuns(Payload, Count, Out);
+            if (Used == 0 && Count > 0) return 0;
+            break;
+        case ColumnEncoding::DeltaBitPack:
+            Used = DecodeDeltas(Payload, Count, Out);
+            if (Used == 0) return 0;
+            break;
+        case ColumnEncoding::ByteShuffle:
+            Used = DecodeShuffled(Payload, Count, Out);
+            if (Used == 0 && Count > 0) return 0;
+            break;
+        default:
+            return 0;
+        }
+        return 1 + Used;
+    }
+} // namespace ColumnCodecDetail
+
+// Appends Count values of Width (1, 2, 4 or 8) bytes. IsFloat selects the
+// float transforms over the integer ones; it is not needed to decode.
+inline void EncodeColumn(const void* Values, std::size_t Count, std::size_t Width, bool IsFloat, std::vector<std::byte>& Out) {
+    using namespace ColumnCodecDetail;
+    switch (Width) {
+    case 1: Encode(static_cast<const std::uint8_t*>(Values), Count, IsFloat, Out); break;
+    case 2: Encode(static_cast<const std::uint16_t*>(Values), Count, IsFloat, Out); break;
+    case 4: Encode(static_cast<const std::uint32_t*>(Values), Count, IsFloat, Out); break;
+    default: Encode(static_cast<const std::uint64_t*>(Values), Count, IsFloat, Out); break;
+    }
+}
+
+// Decodes Count values into Out, which must be aligned for Width. Returns the
+// number of bytes of In consumed, or 0 if In is not a valid column.
+inline std::size_t DecodeColumn(std::span<const std::byte> In, std::size_t Count, std::size_t Width, void* Out) {
+    using namespace ColumnCodecDetail;
+    switch (Width) {
+    case 1: return Decode(In, Count, static_cast<std::uint8_t*>(Out));
+    case 2: return Decode(In, Count, static_cast<std::uint16_t*>(Out));
+    case 4: return Decode(In, Count, static_cast<std::uint32_t*>(Out));
+    case 8: return Decode(In, Count, static_cast<std::uint64_t*>(Out));
+    default: return 0;
+    }
+}
+
+// Whether In is long enough to hold a column of Count values of Width bytes,
+// checked without decoding or allocating. Run-length columns are walked run
+// by run, everything else is bounded by its smallest possible encoding.
+// Loaders call it before sizing buffers from counts read from a file. It
+// does not bound memory: a run-length run of 4 + Width bytes can stand for
+// 2^32 - 1 values, so loaders also cap Count against the input size.
+inline bool ColumnFits(std::span<const std::byte> In, std::size_t Count, std::size_t Width) {
+    using namespace ColumnCodecDetail;
+    const auto RunsFit = [](std::span<const std::byte> Runs, std::size_t Wanted, std::size_t RunWidth) {
+        std::size_t Cursor = 0;
+        for (std::size_t Filled = 0; Filled < Wanted;) {
+            if (Runs.size() - Cursor < sizeof(std::uint32_t) + RunWidth) return false;
+            std::uint32_t Length;
+            std::memcpy(&Length, Runs.data() + Cursor, sizeof(Length));
+            if (Length == 0) return false;
+            Filled += Length;
+            Cursor += sizeof(Length) + RunWidth;
+        }
+        return true;
+    };
+    if (In.empty() || Width == 0) return false;
+    const std::span<const std::byte> Payload = In.subspan(1);
+    switch (static_cast<ColumnEncoding>(In[0])) {
+    case ColumnEncoding::Raw: return Count <= Payload.size() / Width;
+    case ColumnEncoding::RunLength: return RunsFit(Payload, Count, Width);
+    case ColumnEncoding::DeltaBitPack: return Payload.size() >= Padding && (Count + BlockSize - 1) / BlockSize <= Payload.size() - Padding;
+    case ColumnEncoding::ByteShuffle: // The first byte plane alone holds Count bytes.
+        if (Payload.empty()) return false;
+        if (static_cast<ColumnEncoding>(Payload[0]) == ColumnEncoding::Raw) return Count <= Payload.size() - 1;
+        return static_cast<ColumnEncoding>(Payload[0]) == ColumnEncoding::RunLength && RunsFit(Payload.subspan(1), Count, 1);
+    default: return false;
+    }
+}
+
+template <typename F>
+void EncodeColumn(std::span<const F> Values, std::vector<std::byte>& Out) {
+    static_assert(std::is_trivially_copyable_v<F> && (sizeof(F) == 1 || sizeof(F) == 2 || sizeof(F) == 4 || sizeof(F) == 8),
+        "Codec Error: Columns hold trivially copyable values of 1, 2, 4 or 8 bytes.");
+    EncodeColumn(Values.data(), Values.size(), sizeof(F), std::is_floating_point_v<F>, Out);
+}
+
+template <typename F>
+std::size_t DecodeColumn(std::span<const std::byte> In, std::span<F> Values) {
+    return DecodeColumn(In, Values.size(), sizeof(F), Values.data());
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef CODEC_ENABLE_EXAMPLES
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+template <typename F>
+void Measure(const char* Name, const std::vector<F>& Values) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<std::byte> Encoded;
+    EncodeColumn(std::span<const F>(Values), Encoded);
+
+    std::vector<F> Decoded(Values.size());
+    constexpr int Repeats = 20;
+    std::size_t Used = 0;
+    const auto Start = Clock::now();
+    for (int Repeat = 0; Repeat < Repeats; ++Repeat) Used = DecodeColumn(std::span<const std::byte>(Encoded), std::span<F>(Decoded));
+    const double Seconds = std::chrono::duration<double>(Clock::now() - Start).count();
+
+    const std::size_t RawBytes = Values.size() * sizeof(F);
+    const bool Exact = Used == Encoded.size() && std::memcmp(Values.data(), Decoded.data(), RawBytes) == 0;
+    const char* Encodings[] = { "raw", "run length", "delta bit-pack", "byte shuffle" };
+    std::cout << Name << ": " << Encodings[static_cast<int>(Encoded[0])] << ", ratio "
+              << double(RawBytes) / Encoded.size() << ", decode " << RawBytes * Repeats / Seconds / 1e9 << " GB/s"
+              << (Exact ? "" : " (MISMATCH)") << "\n";
+}
+
+int main() {
+    constexpr std::size_t Count = 1 << 20;
+    std::vector<std::uint32_t> Ids(Count);
+    std::vector<std::uint8_t> Tags(Count);
+    std::vector<float> Positions(Count), Scales(Count, 1.0f);
+    for (std::size_t Index = 0; Index < Count; ++Index) {
+        Ids[Index] = static_cast<std::uint32_t>(Index * 3 + Index % 7);
+        Tags[Index] = static_cast<std::uint8_t>((Index / 5000) % 4);
+        Positions[Index] = 1000.0f + float(Index % 4096) * 0.125f;
+    }
+    Measure("Entity ids", Ids);
+    Measure("Team tags", Tags);
+    Measure("Grid positions", Positions);
+    Measure("Scales", Scales);
+    return 0;
+}
+
+#endif // CODEC_ENABLE_EXAMPLES
+
+#endif // COLUMNAR_CODEC_CPP
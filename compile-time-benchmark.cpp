@@ -0,0 +1,249 @@
+#ifndef COMPILE_TIME_BENCHMARK_CPP
+#define COMPILE_TIME_BENCHMARK_CPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <elf.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// --- Tooling: Compile-Time Benchmark ---
+// Template cost is a property of the build, not of the running game, so it
+// needs its own benchmark. This generates translation units that instantiate
+// Composition with N Roles and N Attributes (every Role requires one
+// Attribute) across many distinct Derived types. It then compiles each one
+// and reports:
+// - compiler wall time and peak memory,
+// - object file size,
+// - total and longest symbol name length.
+//
+// Every Derived type lists the Attributes in a different rotation, so the
+// compiler cannot share instantiations between them. A generated function
+// per type touches every Role and Attribute accessor.
+//
+// Results can be saved and compared against a previous run to catch
+// regressions, or to evaluate changes such as replacing std::tuple.
+// Measurement uses fork/exec, wait4 and ELF parsing, so it only runs on Linux.
+
+struct CompileBenchmarkCase {
+    std::size_t MemberCount;  // Roles and Attributes per Composition.
+    std::size_t DerivedCount; // Distinct Composition types in the unit.
+};
+
+struct CompileBenchmarkResult {
+    CompileBenchmarkCase Case{};
+    bool Ok = false;
+    double Seconds = 0.0;
+    double PeakMegabytes = 0.0;
+    std::uint64_t ObjectBytes = 0;
+    std::uint64_t SymbolBytes = 0;
+    std::uint64_t LongestSymbol = 0;
+};
+
+namespace CompileBenchmarkDetail {
+    inline std::string GenerateUnit(const CompileBenchmarkCase& Case, const std::filesystem::path& Core) {
+        const std::size_t N = Case.MemberCount;
+        std::ostringstream Out;
+        Out << "#include \"" << Core.string() << "\"\n\n";
+        for (std::size_t I = 0; I < N; ++I) Out << "struct A" << I << " : Attribute { float Value = 0.0f; };\n";
+        for (std::size_t I = 0; I < N; ++I) {
+            Out << "struct R" << I << " : Role { using RequiredAttributes = TypeList<A" << I << ">; int Counter = 0; };\n";
+        }
+        for (std::size_t D = 0; D < Case.DerivedCount; ++D) {
+            const std::size_t Shift = D % N;
+            Out << "\nclass D" << D << " : public Composition<D" << D << ", TypeList<";
+            for (std::size_t I = 0; I < N; ++I) Out << (I ? ", " : "") << 'R' << I;
+            Out << ">, TypeList<";
+            for (std::size_t I = 0; I < N; ++I) Out << (I ? ", " : "") << 'A' << (I + Shift) % N;
+            Out << ">> {};\n";
+            Out << "float Touch" << D << "(D" << D << "& Object) {\n    float Sum = 0.0f;\n";
+            for (std::size_t I = 0; I < N; ++I) {
+                Out << "    Sum += Object.Attribute<A" << I << ">().Value + float(Object.Role<R" << I << ">().Counter);\n";
+            }
+            Out << "    return Sum;\n}\n";
+        }
+        return Out.str();
+    }
+
+#if defined(__linux__)
+    // Total size and longest entry of the object's symbol string table.
+    inline bool MeasureSymbols(const std::filesystem::path& Object, std::uint64_t& Total, std::uint64_t& Longest) {
+        std::ifstream File(Object, std::ios::binary);
+        std::vector<char> Image((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+        if (Image.size() < sizeof(Elf64_Ehdr) || std::memcmp(Image.data(), ELFMAG, SELFMAG) != 0) return false;
+        Elf64_Ehdr Header;
+        std::memcpy(&Header, Image.data(), sizeof(Header));
+        if (Header.e_ident[EI_CLASS] != ELFCLASS64 || Header.e_shoff + Header.e_shnum * sizeof(Elf64_Shdr) > Image.size()) return false;
+
+        Total = Longest = 0;
+        for (std::size_t Section = 0; Section < Header.e_shnum; ++Section) {
+            Elf64_Shdr Symbols;
+            std::memcpy(&Symbols, Image.data() + Header.e_shoff + Section * sizeof(Elf64_Shdr), sizeof(Symbols));
+            if (Symbols.sh_type != SHT_SYMTAB || Symbols.sh_link >= Header.e_shnum) continue;
+            Elf64_Shdr Strings;
+            std::memcpy(&Strings, Image.data() + Header.e_shoff + Symbols.sh_link * sizeof(Elf64_Shdr), sizeof(Strings));
+            if (Strings.sh_offset + Strings.sh_size > Image.size()) return false;
+            Total += Strings.sh_size;
+            std::uint64_t Current = 0;
+            for (std::uint64_t Offset = 0; Offset < Strings.sh_size; ++Offset) {
+                Current = Image[Strings.sh_offset + Offset] == '\0' ? 0 : Current + 1;
+                Longest = std::max(Longest, Current);
+            }
+        }
+        return true;
+    }
+
+    // Runs Arguments[0] and reports its own wall time and peak resident memory.
+    inline bool RunMeasured(const std::vector<std::string>& Arguments, double& Seconds, double& PeakMegabytes) {
+        const auto Start = std::chrono::steady_clock::now();
+        const pid_t Child = ::fork();
+        if (Child < 0) return false;
+        if (Child == 0) {
+            std::vector<char*> Argv;
+            for (const std::string& Argument : Arguments) Argv.push_back(const_cast<char*>(Argument.c_str()));
+            Argv.push_back(nullptr);
+            ::execvp(Argv[0], Argv.data());
+            ::_exit(127);
+        }
+        int Status = 0;
+        struct rusage Usage {};
+        if (::wait4(Child, &Status, 0, &Usage) != Child) return false;
+        Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+        PeakMegabytes = Usage.ru_maxrss / 1024.0;
+        return WIFEXITED(Status) && WEXITSTATUS(Status) == 0;
+    }
+#endif
+} // namespace CompileBenchmarkDetail
+
+// Generates, compiles and measures one case. Core is the file declaring
+// Composition; Flags are passed to Compiler before "-c".
+inline CompileBenchmarkResult RunCompileBenchmark(const CompileBenchmarkCase& Case, const std::string& Compiler,
+                                                  const std::vector<std::string>& Flags, const std::filesystem::path& Core,
+                                                  const std::filesystem::path& WorkDirectory) {
+    using namespace CompileBenchmarkDetail;
+    CompileBenchmarkResult Result;
+    Result.Case = Case;
+#if defined(__linux__)
+    const std::string Stem = "composition_" + std::to_string(Case.MemberCount) + "x" + std::to_string(Case.DerivedCount);
+    const std::filesystem::path Source = WorkDirectory / (Stem + ".cpp"), Object = WorkDirectory / (Stem + ".o");
+    std::ofstream(Source) << GenerateUnit(Case, Core);
+
+    std::vector<std::string> Arguments{ Compiler };
+    Arguments.insert(Arguments.end(), Flags.begin(), Flags.end());
+    Arguments.insert(Arguments.end(), { "-c", Source.string(), "-o", Object.string() });
+    Result.Ok = RunMeasured(Arguments, Result.Seconds, Result.PeakMegabytes)
+        && MeasureSymbols(Object, Result.SymbolBytes, Result.LongestSymbol);
+    std::error_code Error;
+    Result.ObjectBytes = Result.Ok ? std::filesystem::file_size(Object, Error) : 0;
+#else
+    (void)Compiler, (void)Flags, (void)Core, (void)WorkDirectory;
+#endif
+    return Result;
+}
+
+// One line per result: members, derived, seconds, megabytes, object, symbols, longest.
+inline void SaveCompileBenchmark(const std::vector<CompileBenchmarkResult>& Results, const std::string& Path) {
+    std::ofstream Out(Path);
+    for (const CompileBenchmarkResult& Entry : Results) {
+        Out << Entry.Case.MemberCount << ' ' << Entry.Case.DerivedCount << ' ' << Entry.Seconds << ' ' << Entry.PeakMegabytes
+            << ' ' << Entry.ObjectBytes << ' ' << Entry.SymbolBytes << ' ' << Entry.LongestSymbol << '\n';
+    }
+}
+
+inline std::vector<CompileBenchmarkResult> LoadCompileBenchmark(const std::string& Path) {
+    std::vector<CompileBenchmarkResult> Results;
+    std::ifstream In(Path);
+    CompileBenchmarkResult Entry;
+    while (In >> Entry.Case.MemberCount >> Entry.Case.DerivedCount >> Entry.Seconds >> Entry.PeakMegabytes
+              >> Entry.ObjectBytes >> Entry.SymbolBytes >> Entry.LongestSymbol) {
+        Entry.Ok = true;
+        Results.push_back(Entry);
+    }
+    return Results;
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef COMPILE_BENCHMARK_ENABLE_EXAMPLES
+
+#include <iomanip>
+#include <iostream>
+
+// Where role-based-design.cpp lives when --source is not given. Builds that
+// move the binary away from the sources should pass -DBENCH_SOURCE_DIR=...
+#ifndef BENCH_SOURCE_DIR
+#define BENCH_SOURCE_DIR "."
+#endif
+
+// compile-time-benchmark [--source dir] [--compiler c++] [--derived 16] [--save file] [--compare file] [-- flags]
+// Flags default to -std=c++20 -O0, which keeps accessor instantiations as
+// symbols the way debug builds see them.
+// Exits with 2 when role-based-design.cpp cannot be found, and with 1 when a
+// case fails to compile or, with --compare, when compile time or peak memory
+// regresses by more than 10% (or object or symbol sizes by more than 1%)
+// against the saved run.
+int main(int ArgumentCount, char** Arguments) {
+    std::string SourceDirectory = BENCH_SOURCE_DIR, Compiler = "c++", SavePath, ComparePath;
+    std::size_t DerivedCount = 16;
+    std::vector<std::string> Flags{ "-std=c++20", "-O0" };
+    for (int Index = 1; Index < ArgumentCount; ++Index) {
+        const std::string Argument = Arguments[Index];
+        const bool HasValue = Index + 1 < ArgumentCount;
+        if (Argument == "--source" && HasValue) SourceDirectory = Arguments[++Index];
+        else if (Argument == "--compiler" && HasValue) Compiler = Arguments[++Index];
+        else if (Argument == "--derived" && HasValue) DerivedCount = std::stoul(Arguments[++Index]);
+        else if (Argument == "--save" && HasValue) SavePath = Arguments[++Index];
+        else if (Argument == "--compare" && HasValue) ComparePath = Arguments[++Index];
+        else if (Argument == "--") Flags.assign(Arguments + Index + 1, Arguments + ArgumentCount), Index = ArgumentCount;
+    }
+
+    const std::filesystem::path Core = std::filesystem::absolute(std::filesystem::path(SourceDirectory) / "role-based-design.cpp").lexically_normal();
+    if (!std::filesystem::is_regular_file(Core)) {
+        std::cerr << "compile-time-benchmark: " << Core.string() << " not found; pass --source <dir> or build with -DBENCH_SOURCE_DIR=<dir>.\n";
+        return 2;
+    }
+    const std::filesystem::path WorkDirectory = std::filesystem::temp_directory_path() / "composition-compile-benchmark";
+    std::filesystem::create_directories(WorkDirectory);
+
+    const std::vector<CompileBenchmarkResult> Baseline = ComparePath.empty() ? std::vector<CompileBenchmarkResult>{} : LoadCompileBenchmark(ComparePath);
+    std::vector<CompileBenchmarkResult> Results;
+    bool Regressed = false;
+    std::cout << "members derived   seconds  peak MB  object KB  symbols KB  longest symbol\n";
+    for (const std::size_t Members : { 8u, 32u, 128u }) {
+        const CompileBenchmarkResult& Entry = Results.emplace_back(
+            RunCompileBenchmark({ Members, DerivedCount }, Compiler, Flags, Core, WorkDirectory));
+        std::cout << std::setw(7) << Members << std::setw(8) << DerivedCount << std::fixed << std::setprecision(2)
+                  << std::setw(10) << Entry.Seconds << std::setw(9) << Entry.PeakMegabytes
+                  << std::setw(11) << Entry.ObjectBytes / 1024 << std::setw(12) << Entry.SymbolBytes / 1024
+                  << std::setw(16) << Entry.LongestSymbol << (Entry.Ok ? "" : "  FAILED") << '\n';
+        Regressed = Regressed || !Entry.Ok;
+        for (const CompileBenchmarkResult& Previous : Baseline) {
+            if (Previous.Case.MemberCount != Members || Previous.Case.DerivedCount != DerivedCount) continue;
+            const auto Worse = [](double Now, double Before, double Tolerance) { return Now > Before * (1.0 + Tolerance); };
+            if (Worse(Entry.Seconds, Previous.Seconds, 0.10) || Worse(Entry.PeakMegabytes, Previous.PeakMegabytes, 0.10)
+                || Worse(double(Entry.ObjectBytes), double(Previous.ObjectBytes), 0.01)
+                || Worse(double(Entry.SymbolBytes), double(Previous.SymbolBytes), 0.01)) {
+                std::cout << "        regression against " << ComparePath << '\n';
+                Regressed = true;
+            }
+        }
+    }
+    if (!SavePath.empty()) SaveCompileBenchmark(Results, SavePath);
+    std::filesystem::remove_all(WorkDirectory);
+    return Regressed ? 1 : 0;
+}
+
+#endif // COMPILE_BENCHMARK_ENABLE_EXAMPLES
+
+#endif // COMPILE_TIME_BENCHMARK_CPP
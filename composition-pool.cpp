@@ -0,0 +1,524 @@
+#ifndef COMPOSITION_POOL_CPP
+#define COMPOSITION_POOL_CPP
+
+#include "role-based-design.cpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+// --- Tier 3: Pooled Composition Storage ---
+// A pool keeps the Attributes of many instances of one Composition type in
+// fixed-capacity chunks, one contiguous column per Attribute type (SoA).
+// Instances are densely packed: index I lives in chunk I / ChunkCapacity, and
+// Despawn() swaps the last instance into the hole.
+//
+// Every mutable access stamps the touched chunk, and the touched column within
+// it, with the pool's current version. Snapshot, hashing, persistence and
+// replication passes use those stamps to only visit what changed since they
+// last looked.
+//
+// Roles are not stored per instance. The pool keeps one shared instance of
+// each Role that has lifecycle hooks, and calls them over whole chunk ranges,
+// one Role at a time: OnCreate then OnEnable after Spawn() and SpawnDefault(),
+// OnDestroy before Despawn() and Clear(). Moving chunks between pools does not
+// run hooks, and neither does destroying the pool. Loaders that fill columns
+// in bulk, or move chunks in from a staging pool, call RunSpawnHooks() on the
+// live pool once the instances hold their final values.
+
+namespace CompositionPoolDetail {
+    // Places Count columns of Capacity elements each, every column aligned to
+    // at least ColumnAlignment, and returns the chunk size. Shared with pools
+    // whose Attributes are only known at run time, so both lay out the same
+    // Attribute list identically.
+    constexpr std::size_t LayOutColumns(const std::size_t* Sizes, const std::size_t* Alignments, std::size_t Count,
+                                        std::size_t Capacity, std::size_t ColumnAlignment, std::size_t* Offsets) {
+        std::size_t Cursor = 0;
+        for (std::size_t I = 0; I < Count; ++I) {
+            const std::size_t Align = Alignments[I] > ColumnAlignment ? Alignments[I] : ColumnAlignment;
+            Cursor = (Cursor + Align - 1) / Align * Align;
+            Offsets[I] = Cursor;
+            Cursor += Sizes[I] * Capacity;
+        }
+        return (Cursor + ColumnAlignment - 1) / ColumnAlignment * ColumnAlignment;
+    }
+} // namespace CompositionPoolDetail
+
+template <typename TComposition, std::size_t ChunkCapacity = 256,
+          typename AttributesList = typename TComposition::AttributesList>
+class CompositionPool;
+
+template <typename TComposition, std::size_t ChunkCapacity, typename... TAttributes>
+class CompositionPool<TComposition, ChunkCapacity, TypeList<TAttributes...>> {
+public:
+    using CompositionType = TComposition;
+
+    static constexpr std::size_t Capacity        = ChunkCapacity;
+    static constexpr std::size_t AttributeCount  = sizeof...(TAttributes);
+    static constexpr std::size_t ColumnAlignment = 64; // Cache line, and wide enough for any SIMD load.
+
+    template <std::size_t I>
+    using AttributeAt = TypeAt<TypeList<TAttributes...>, I>;
+
+    static_assert(ChunkCapacity > 0, "CompositionPool Error: ChunkCapacity must be non-zero.");
+    static_assert(AttributeCount > 0, "CompositionPool Error: A pooled Composition needs at least one Attribute.");
+
+private:
+    static constexpr std::array<std::size_t, AttributeCount + 1> ComputeColumnOffsets() {
+        constexpr std::size_t Sizes[]      = { sizeof(TAttributes)... };
+        constexpr std::size_t Alignments[] = { alignof(TAttributes)... };
+        std::array<std::size_t, AttributeCount + 1> Offsets{};
+        Offsets[AttributeCount] = CompositionPoolDetail::LayOutColumns(Sizes, Alignments, AttributeCount, ChunkCapacity, ColumnAlignment, Offsets.data());
+        return Offsets;
+    }
+
+public:
+    template <typename T>
+    static constexpr std::size_t ColumnIndex = IndexOf<TypeList<TAttributes...>, T>;
+
+    static constexpr std::array<std::size_t, AttributeCount + 1> ColumnOffsets = ComputeColumnOffsets();
+    static constexpr std::size_t ChunkBytes = ColumnOffsets[AttributeCount];
+    static constexpr bool IsTriviallyCopyable = (std::is_trivially_copyable_v<TAttributes> && ...);
+
+    // One fixed-size block of columns. Copying a chunk copies only the live
+    // prefix of each column: a single memcpy per column for trivially copyable
+    // Attributes, element-wise copies otherwise.
+    class Chunk {
+    public:
+        Chunk() = default;
+        Chunk(const Chunk& Other) { CopyFrom(Other); }
+        Chunk& operator=(const Chunk& Other) {
+            if (this != &Other) CopyFrom(Other);
+            return *this;
+        }
+        ~Chunk() { Resize(0); }
+
+        template <std::size_t I>
+        AttributeAt<I>* Column() {
+            return std::launder(reinterpret_cast<AttributeAt<I>*>(Data + ColumnOffsets[I]));
+        }
+        template <std::size_t I>
+        const AttributeAt<I>* Column() const {
+            return std::launder(reinterpret_cast<const AttributeAt<I>*>(Data + ColumnOffsets[I]));
+        }
+
+        std::uint32_t Size() const { return Count; }
+        std::byte* Bytes() { return Data; }
+        const std::byte* Bytes() const { return Data; }
+
+    private:
+        friend class CompositionPool;
+
+        template <std::size_t... I>
+        void CopyColumns(const Chunk& Other, std::index_sequence<I...>) { (CopyColumn<I>(Other), ...); }
+
+        template <std::size_t I>
+        void CopyColumn(const Chunk& Other) {
+            using T = AttributeAt<I>;
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                std::memcpy(Data + ColumnOffsets[I], Other.Data + ColumnOffsets[I], sizeof(T) * Other.Count);
+            } else {
+                T* To = Column<I>();
+                const T* From = Other.Column<I>();
+                const std::uint32_t Shared = Count < Other.Count ? Count : Other.Count;
+                for (std::uint32_t Slot = 0; Slot < Shared; ++Slot) To[Slot] = From[Slot];
+                for (std::uint32_t Slot = Shared; Slot < Other.Count; ++Slot) ::new (To + Slot) T(From[Slot]);
+                for (std::uint32_t Slot = Other.Count; Slot < Count; ++Slot) To[Slot].~T();
+            }
+        }
+
+        void CopyFrom(const Chunk& Other) {
+            CopyColumns(Other, std::index_sequence_for<TAttributes...>{});
+            Count = Other.Count;
+        }
+
+        template <std::size_t... I>
+        void DestroyRange(std::uint32_t From, std::uint32_t To, std::index_sequence<I...>) {
+            (DestroyColumnRange<I>(From, To), ...);
+        }
+
+        template <std::size_t I>
+        void DestroyColumnRange(std::uint32_t From, std::uint32_t To) {
+            if constexpr (!std::is_trivially_destructible_v<AttributeAt<I>>) {
+                for (std::uint32_t Slot = From; Slot < To; ++Slot) Column<I>()[Slot].~AttributeAt<I>();
+            }
+        }
+
+        void Resize(std::uint32_t NewCount) {
+            if (NewCount < Count) DestroyRange(NewCount, Count, std::index_sequence_for<TAttributes...>{});
+            Count = NewCount;
+        }
+
+        alignas(ColumnAlignment) std::byte Data[ChunkBytes];
+        std::uint32_t Count = 0;
+    };
+
+    // What a pooled Role's hooks receive as their host: one instance's
+    // Attributes, addressed by chunk and slot. The surrounding Spawn() or
+    // Despawn() already stamps the chunk, so access through it does not.
+    class InstanceHost {
+    public:
+        template <typename T> static constexpr bool HasAttribute() { return ColumnIndex<T> < AttributeCount; }
+        template <typename T> static constexpr bool HasRole() { return TComposition::template HasRole<T>(); }
+
+        template <typename T>
+        T& Attribute() const {
+            static_assert(HasAttribute<T>(), "Attempted to access an Attribute that is not pooled.");
+            return Target->template Column<ColumnIndex<T>>()[Slot];
+        }
+
+        std::size_t Index() const { return InstanceIndex; }
+
+    private:
+        friend class CompositionPool;
+        InstanceHost(Chunk& InTarget, std::uint32_t InSlot, std::size_t InIndex) : Target(&InTarget), Slot(InSlot), InstanceIndex(InIndex) {}
+
+        Chunk* Target;
+        std::uint32_t Slot;
+        std::size_t InstanceIndex;
+    };
+
+    CompositionPool() = default;
+    CompositionPool(const CompositionPool&) = delete;
+    CompositionPool& operator=(const CompositionPool&) = delete;
+
+    // --- Instances ---
+    std::size_t Spawn(TAttributes... InAttributes) {
+        const std::size_t Index = InstanceCount;
+        const std::size_t ChunkIndex = Index / ChunkCapacity;
+        if (ChunkIndex == Chunks.size()) {
+            Chunks.push_back(std::make_unique<Chunk>());
+            Stamps.emplace_back();
+        }
+        Chunk& Target = *Chunks[ChunkIndex];
+        const std::uint32_t Slot = Target.Count;
+        ConstructAt(Target, Slot, std::index_sequence_for<TAttributes...>{}, std::move(InAttributes)...);
+        Target.Count = Slot + 1;
+        ++InstanceCount;
+        Touch(ChunkIndex);
+        RunHooks<LifecycleEvent::Create>(ChunkIndex, Slot, Slot + 1);
+        RunHooks<LifecycleEvent::Enable>(ChunkIndex, Slot, Slot + 1);
+        return Index;
+    }
+
+    // Appends Count value-initialized instances, runs their OnCreate and
+    // OnEnable hooks, and returns the first index.
+    std::size_t SpawnDefault(std::size_t Count) {
+        const std::size_t First = AllocateDefault(Count);
+        RunSpawnHooks(First, Count);
+        return First;
+    }
+
+    // Appends Count value-initialized instances without running hooks, and
+    // returns the first index. Loaders fill the columns in bulk afterwards and
+    // then call RunSpawnHooks(), so hooks see the loaded values.
+    std::size_t AllocateDefault(std::size_t Count) {
+        const std::size_t First = InstanceCount;
+        while (Count > 0) {
+            const std::size_t ChunkIndex = InstanceCount / ChunkCapacity;
+            if (ChunkIndex == Chunks.size()) {
+                Chunks.push_back(std::make_unique<Chunk>());
+                Stamps.emplace_back();
+            }
+            Chunk& Target = *Chunks[ChunkIndex];
+            const std::uint32_t Added = static_cast<std::uint32_t>(std::min<std::size_t>(Count, ChunkCapacity - Target.Count));
+            const std::uint32_t From = Target.Count;
+            ConstructDefault(Target, From, From + Added, std::index_sequence_for<TAttributes...>{});
+            Target.Count += Added;
+            InstanceCount += Added;
+            Count -= Added;
+            Touch(ChunkIndex);
+        }
+        return First;
+    }
+
+    // Runs OnCreate then OnEnable for instances [First, First + Count), a
+    // chunk range at a time. For instances added by AllocateDefault() or
+    // AppendChunk(), which run no hooks themselves.
+    void RunSpawnHooks(std::size_t First, std::size_t Count) {
+        while (Count > 0) {
+            const std::size_t ChunkIndex = First / ChunkCapacity;
+            const std::uint32_t From = static_cast<std::uint32_t>(First % ChunkCapacity);
+            const std::uint32_t To = static_cast<std::uint32_t>(std::min<std::size_t>(ChunkCapacity, From + Count));
+            RunHooks<LifecycleEvent::Create>(ChunkIndex, From, To);
+            RunHooks<LifecycleEvent::Enable>(ChunkIndex, From, To);
+            First += To - From;
+            Count -= To - From;
+        }
+    }
+
+    // Removes an instance by moving the last instance into its slot. Indices
+    // of other instances stay valid except for the previously last one.
+    void Despawn(std::size_t Index) {
+        const std::size_t Last = InstanceCount - 1;
+        const std::size_t ChunkIndex = Index / ChunkCapacity, LastChunkIndex = Last / ChunkCapacity;
+        RunHooks<LifecycleEvent::Destroy>(ChunkIndex, static_cast<std::uint32_t>(Index % ChunkCapacity), static_cast<std::uint32_t>(Index % ChunkCapacity) + 1);
+        Chunk& Hole = *Chunks[ChunkIndex];
+        Chunk& Tail = *Chunks[LastChunkIndex];
+        if (Index != Last) {
+            MoveSlot(Tail, Last % ChunkCapacity, Hole, Index % ChunkCapacity, std::index_sequence_for<TAttributes...>{});
+            Touch(ChunkIndex);
+        }
+        Tail.Resize(Tail.Count - 1);
+        --InstanceCount;
+        Touch(LastChunkIndex);
+    }
+
+    // Exchanges the Attributes of two instances. For code that keeps the pool
+    // in a particular order; no hooks run.
+    void Swap(std::size_t A, std::size_t B) {
+        if (A == B) return;
+        SwapSlots(*Chunks[A / ChunkCapacity], A % ChunkCapacity, *Chunks[B / ChunkCapacity], B % ChunkCapacity, std::index_sequence_for<TAttributes...>{});
+        Touch(A / ChunkCapacity);
+        Touch(B / ChunkCapacity);
+    }
+
+    // Despawns every instance, running OnDestroy a chunk at a time.
+    void Clear() {
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Chunks.size(); ++ChunkIndex) RunHooks<LifecycleEvent::Destroy>(ChunkIndex, 0, Chunks[ChunkIndex]->Count);
+        while (!Chunks.empty()) PopChunk();
+        InstanceCount = 0;
+    }
+
+    std::size_t Size() const { return InstanceCount; }
+
+    template <typename T>
+    T& Attribute(std::size_t Index) {
+        return MutableColumn<T>(Index / ChunkCapacity)[Index % ChunkCapacity];
+    }
+    template <typename T>
+    const T& Attribute(std::size_t Index) const {
+        return Column<T>(Index / ChunkCapacity)[Index % ChunkCapacity];
+    }
+
+    // --- Chunks ---
+    std::size_t ChunkCount() const { return Chunks.size(); }
+    std::uint32_t ChunkSize(std::size_t ChunkIndex) const { return Chunks[ChunkIndex]->Count; }
+
+    template <typename T>
+    const T* Column(std::size_t ChunkIndex) const {
+        static_assert(ColumnIndex<T> < AttributeCount, "Attempted to access an Attribute that is not pooled.");
+        return Chunks[ChunkIndex]->template Column<ColumnIndex<T>>();
+    }
+
+    template <typename T>
+    T* MutableColumn(std::size_t ChunkIndex) {
+        static_assert(ColumnIndex<T> < AttributeCount, "Attempted to access an Attribute that is not pooled.");
+        TouchColumn(ChunkIndex, ColumnIndex<T>);
+        return Chunks[ChunkIndex]->template Column<ColumnIndex<T>>();
+    }
+
+    // Untyped column access by column index, for queries that resolve columns
+    // at run time.
+    const std::byte* ColumnBytes(std::size_t ChunkIndex, std::size_t Column) const {
+        return Chunks[ChunkIndex]->Bytes() + ColumnOffsets[Column];
+    }
+    std::byte* MutableColumnBytes(std::size_t ChunkIndex, std::size_t Column) {
+        TouchColumn(ChunkIndex, Column);
+        return Chunks[ChunkIndex]->Bytes() + ColumnOffsets[Column];
+    }
+
+    const Chunk& GetChunk(std::size_t ChunkIndex) const { return *Chunks[ChunkIndex]; }
+
+    // Overwrites a chunk's contents from a snapshot copy. ChunkIndex must be
+    // below ChunkCount(): callers restoring several chunks size the pool with
+    // ResizeChunks() first, and are responsible for leaving it densely
+    // packed, i.e. restoring a consistent set of chunks.
+    void RestoreChunk(std::size_t ChunkIndex, const Chunk& From) {
+        Chunk& Target = *Chunks[ChunkIndex];
+        InstanceCount = InstanceCount - Target.Count + From.Count;
+        Target = From;
+        Touch(ChunkIndex);
+    }
+
+    // Sets the number of chunks, appending empty ones or dropping trailing
+    // ones together with their instances. Like RestoreChunk(), it is for
+    // restoring snapshots: no hooks run, and the caller is responsible for
+    // leaving the pool densely packed.
+    void ResizeChunks(std::size_t Count) {
+        while (Chunks.size() > Count) {
+            InstanceCount -= Chunks.back()->Count;
+            PopChunk();
+        }
+        while (Chunks.size() < Count) {
+            Chunks.push_back(std::make_unique<Chunk>());
+            Stamps.emplace_back();
+            Touch(Chunks.size() - 1);
+        }
+    }
+
+    // Detaches every chunk together with its instances, in order, and leaves
+    // the pool empty. Staging pools use this to hand whole chunks to a live
+    // pool without copying them; no hooks run.
+    std::vector<std::unique_ptr<Chunk>> ReleaseChunks() {
+        std::vector<std::unique_ptr<Chunk>> Released;
+        for (std::unique_ptr<Chunk>& Detached : Chunks) {
+            if (Detached->Count > 0) Released.push_back(std::move(Detached));
+        }
+        Chunks.clear();
+        Stamps.clear();
+        ChangedChunkList.clear();
+        InstanceCount = 0;
+        return Released;
+    }
+
+    // Takes ownership of a chunk's instances and appends them after the last
+    // instance, in slot order. No instance already in the pool is moved or
+    // renumbered. If the pool's last chunk is full, the chunk is adopted as
+    // it is, without copying; otherwise its first instances top up the last
+    // chunk, and the rest move down to the front of the incoming chunk, one
+    // relocation per instance.
+    void AppendChunk(std::unique_ptr<Chunk> Incoming) {
+        if (Incoming->Count == 0) return;
+        if (InstanceCount % ChunkCapacity != 0) {
+            const std::size_t TailIndex = InstanceCount / ChunkCapacity;
+            Chunk& Tail = *Chunks[TailIndex];
+            const std::uint32_t Moved = std::min(static_cast<std::uint32_t>(ChunkCapacity) - Tail.Count, Incoming->Count);
+            for (std::uint32_t Slot = 0; Slot < Moved; ++Slot) {
+                RelocateSlot(*Incoming, Slot, Tail, Tail.Count + Slot, std::index_sequence_for<TAttributes...>{});
+            }
+            Tail.Count += Moved;
+            InstanceCount += Moved;
+            Touch(TailIndex);
+            const std::uint32_t Left = Incoming->Count - Moved;
+            for (std::uint32_t Slot = 0; Slot < Left; ++Slot) {
+                RelocateSlot(*Incoming, Moved + Slot, *Incoming, Slot, std::index_sequence_for<TAttributes...>{});
+            }
+            Incoming->Count = Left;
+            if (Left == 0) return;
+        }
+        const std::size_t ChunkIndex = InstanceCount / ChunkCapacity;
+        if (ChunkIndex == Chunks.size()) {
+            Chunks.push_back(nullptr);
+            Stamps.emplace_back();
+        }
+        InstanceCount += Incoming->Count;
+        Chunks[ChunkIndex] = std::move(Incoming);
+        Touch(ChunkIndex);
+    }
+
+    // --- Change Tracking ---
+    std::uint64_t Version() const { return CurrentVersion; }
+    std::uint64_t ChunkVersion(std::size_t ChunkIndex) const { return Stamps[ChunkIndex].Chunk; }
+    std::uint64_t ColumnVersion(std::size_t ChunkIndex, std::size_t Column) const { return Stamps[ChunkIndex].Columns[Column]; }
+
+    // Chunks stamped with the current version, in first-touch order.
+    const std::vector<std::uint32_t>& ChangedChunks() const { return ChangedChunkList; }
+
+    void AdvanceVersion() {
+        ++CurrentVersion;
+        ChangedChunkList.clear();
+    }
+
+private:
+    template <typename TRole>
+    struct IsHooked : std::bool_constant<HasAnyLifecycleHook<TRole, InstanceHost>> {};
+
+    template <typename TRolesList>
+    struct HookStorage;
+    template <typename... TRoles>
+    struct HookStorage<TypeList<TRoles...>> {
+        static_assert((std::is_default_constructible_v<TRoles> && ...),
+            "CompositionPool Error: A Role with lifecycle hooks must be default constructible; the pool keeps one shared instance of it.");
+        using Type = CompositionDetail::Storage<CompositionDetail::RoleTag, ::Role, TRoles...>;
+    };
+
+    using HookedRoles = Filter<typename TComposition::RolesList, IsHooked>;
+
+    // Calls Event's hook of every hooked Role for slots [From, To) of a chunk,
+    // one Role over the whole range at a time. Destroy goes in reverse order.
+    template <LifecycleEvent Event>
+    void RunHooks(std::size_t ChunkIndex, std::uint32_t From, std::uint32_t To) {
+        if constexpr (ListSize<HookedRoles> > 0) RunHooks<Event>(ChunkIndex, From, To, std::make_index_sequence<ListSize<HookedRoles>>{});
+    }
+
+    template <LifecycleEvent Event, std::size_t... I>
+    void RunHooks(std::size_t ChunkIndex, std::uint32_t From, std::uint32_t To, std::index_sequence<I...>) {
+        constexpr std::size_t Last = sizeof...(I) - 1;
+        (RunRoleHooks<Event, TypeAt<HookedRoles, Event == LifecycleEvent::Destroy ? Last - I : I>>(ChunkIndex, From, To), ...);
+    }
+
+    template <LifecycleEvent Event, typename TRole>
+    void RunRoleHooks(std::size_t ChunkIndex, std::uint32_t From, std::uint32_t To) {
+        if constexpr (HasLifecycleHook<TRole, InstanceHost, Event>) {
+            TRole& Shared = static_cast<CompositionDetail::Member<CompositionDetail::RoleTag, TRole>&>(Hooks).Value;
+            Chunk& Target = *Chunks[ChunkIndex];
+            for (std::uint32_t Slot = From; Slot < To; ++Slot) {
+                InstanceHost Host(Target, Slot, ChunkIndex * ChunkCapacity + Slot);
+                InvokeLifecycleHook<Event>(Shared, Host);
+            }
+        }
+    }
+
+    struct ChunkStamps {
+        std::uint64_t Chunk = 0;
+        std::array<std::uint64_t, AttributeCount> Columns{};
+    };
+
+    // Stamps the chunk and every column: instances were added, moved or removed.
+    void Touch(std::size_t ChunkIndex) {
+        StampChunk(ChunkIndex);
+        Stamps[ChunkIndex].Columns.fill(CurrentVersion);
+    }
+
+    void TouchColumn(std::size_t ChunkIndex, std::size_t Column) {
+        StampChunk(ChunkIndex);
+        Stamps[ChunkIndex].Columns[Column] = CurrentVersion;
+    }
+
+    void StampChunk(std::size_t ChunkIndex) {
+        if (Stamps[ChunkIndex].Chunk != CurrentVersion) {
+            Stamps[ChunkIndex].Chunk = CurrentVersion;
+            ChangedChunkList.push_back(static_cast<std::uint32_t>(ChunkIndex));
+        }
+    }
+
+    template <std::size_t... I, typename... TArgs>
+    static void ConstructAt(Chunk& Target, std::uint32_t Slot, std::index_sequence<I...>, TArgs&&... Args) {
+        (::new (Target.template Column<I>() + Slot) AttributeAt<I>(std::forward<TArgs>(Args)), ...);
+    }
+
+    void PopChunk() {
+        Chunks.pop_back();
+        Stamps.pop_back();
+        const std::uint32_t Removed = static_cast<std::uint32_t>(Chunks.size());
+        ChangedChunkList.erase(std::remove(ChangedChunkList.begin(), ChangedChunkList.end(), Removed), ChangedChunkList.end());
+    }
+
+    // Move-constructs into an unconstructed slot and destroys the source.
+    template <std::size_t... I>
+    static void RelocateSlot(Chunk& From, std::size_t FromSlot, Chunk& To, std::size_t ToSlot, std::index_sequence<I...>) {
+        ((::new (To.template Column<I>() + ToSlot) AttributeAt<I>(std::move(From.template Column<I>()[FromSlot])),
+          From.template Column<I>()[FromSlot].~AttributeAt<I>()), ...);
+    }
+
+    template <std::size_t... I>
+    static void ConstructDefault(Chunk& Target, std::uint32_t From, std::uint32_t To, std::index_sequence<I...>) {
+        (std::uninitialized_value_construct(Target.template Column<I>() + From, Target.template Column<I>() + To), ...);
+    }
+
+    template <std::size_t... I>
+    static void MoveSlot(Chunk& From, std::size_t FromSlot, Chunk& To, std::size_t ToSlot, std::index_sequence<I...>) {
+        ((To.template Column<I>()[ToSlot] = std::move(From.template Column<I>()[FromSlot])), ...);
+    }
+
+    template <std::size_t... I>
+    static void SwapSlots(Chunk& First, std::size_t FirstSlot, Chunk& Second, std::size_t SecondSlot, std::index_sequence<I...>) {
+        using std::swap;
+        (swap(First.template Column<I>()[FirstSlot], Second.template Column<I>()[SecondSlot]), ...);
+    }
+
+    [[no_unique_address]] typename HookStorage<HookedRoles>::Type Hooks;
+    std::vector<std::unique_ptr<Chunk>> Chunks;
+    std::vector<ChunkStamps> Stamps;
+    std::vector<std::uint32_t> ChangedChunkList;
+    std::size_t InstanceCount = 0;
+    std::uint64_t CurrentVersion = 1;
+};
+
+#endif // COMPOSITION_POOL_CPP
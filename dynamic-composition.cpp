@@ -0,0 +1,658 @@
+#ifndef DYNAMIC_COMPOSITION_CPP
+#define DYNAMIC_COMPOSITION_CPP
+
+#include "composition-pool.cpp"
+#include "type-ids.cpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// --- Tier 4: Dynamic Compositions ---
+// Modders define object types in data, after the game is compiled, which the
+// TypeLists of a Composition cannot express. A DynamicComposition is
+// assembled at run time from registered Attribute and Role types. Each type
+// is described by a TypeDescriptor: its stable id, dense index and size, and
+// a flat table of functions that construct, relocate, destroy and (for Roles)
+// update or run lifecycle hooks over a whole range of values at once. The same dependency rules as for
+// static Compositions are checked when the type is built, and reported as an
+// error instead of a static_assert.
+//
+// A DynamicPool lays out its chunks exactly like a CompositionPool with the
+// same Attributes in the same order. It calls through the tables once per
+// column or Role per chunk, never per instance, and runs OnCreate, OnEnable
+// and OnDestroy hooks when and in the order a CompositionPool would. Queries do not care which
+// kind of pool they read: ArchetypeSource reduces either one to its
+// signature and column lookup, and ForEachChunk<Ts...>() runs over any mix of
+// the two.
+
+class DynamicComposition;
+
+// A chunk of a DynamicPool, as handed to a Role's update function.
+struct DynamicChunkView {
+    const DynamicComposition* Type;
+    std::byte* Data;
+    std::uint32_t Count;
+    std::size_t FirstIndex;
+};
+
+// The host a Role's Update(Host&, DeltaTime) receives inside a DynamicPool.
+// Which Attributes exist is only known at run time, so HasAttribute<T>() is
+// not constexpr. Roles should use the Attributes they require, which were
+// checked when the DynamicComposition was built.
+class DynamicInstanceHost {
+public:
+    DynamicInstanceHost(const DynamicChunkView& InChunk, std::uint32_t InSlot) : Chunk(&InChunk), Slot(InSlot) {}
+
+    template <typename T> bool HasAttribute() const;
+    template <typename T> T& Attribute() const;
+    std::size_t Index() const { return Chunk->FirstIndex + Slot; }
+
+private:
+    const DynamicChunkView* Chunk;
+    std::uint32_t Slot;
+};
+
+template <typename TRole>
+concept HasDynamicUpdate = requires(TRole& InRole, DynamicInstanceHost& InHost, float DeltaTime) { InRole.Update(InHost, DeltaTime); };
+
+struct TypeDescriptor {
+    std::uint64_t Id;
+    std::uint32_t Index; // Dense index within Attributes or within Roles.
+    std::string_view Name;
+    std::size_t Size;
+    std::size_t Alignment;
+    bool IsRole;
+    AttributeMask RequiredAttributes; // Roles only.
+    TypeMask<> RequiredRoles;         // Roles only, including indirect requirements.
+
+    void (*Construct)(void* At, std::size_t Count);              // Value-initializes.
+    void (*Relocate)(void* To, void* From, std::size_t Count);   // Moves into raw memory, destroys the source.
+    void (*Destroy)(void* At, std::size_t Count);
+    void (*Update)(void* Role, const DynamicChunkView& Chunk, float DeltaTime); // Null unless the Role has Update().
+
+    // Run the hook for slots [From, To) of a chunk. Null unless the Role has it.
+    using HookFunction = void (*)(void* Role, const DynamicChunkView& Chunk, std::uint32_t From, std::uint32_t To);
+    HookFunction OnCreate;
+    HookFunction OnEnable;
+    HookFunction OnDestroy;
+};
+
+namespace DynamicDetail {
+    template <typename T>
+    void Construct(void* At, std::size_t Count) { std::uninitialized_value_construct_n(static_cast<T*>(At), Count); }
+
+    template <typename T>
+    void Relocate(void* To, void* From, std::size_t Count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(To, From, Count * sizeof(T));
+        } else {
+            std::uninitialized_move_n(static_cast<T*>(From), Count, static_cast<T*>(To));
+            std::destroy_n(static_cast<T*>(From), Count);
+        }
+    }
+
+    template <typename T>
+    void Destroy(void* At, std::size_t Count) { std::destroy_n(static_cast<T*>(At), Count); }
+
+    template <typename T>
+    void Update(void* InRole, const DynamicChunkView& Chunk, float DeltaTime) {
+        T& Shared = *static_cast<T*>(InRole);
+        for (std::uint32_t Slot = 0; Slot < Chunk.Count; ++Slot) {
+            DynamicInstanceHost Host(Chunk, Slot);
+            Shared.Update(Host, DeltaTime);
+        }
+    }
+
+    template <typename T, LifecycleEvent Event>
+    void Hook(void* InRole, const DynamicChunkView& Chunk, std::uint32_t From, std::uint32_t To) {
+        T& Shared = *static_cast<T*>(InRole);
+        for (std::uint32_t Slot = From; Slot < To; ++Slot) {
+            DynamicInstanceHost Host(Chunk, Slot);
+            InvokeLifecycleHook<Event>(Shared, Host);
+        }
+    }
+
+    template <typename T, LifecycleEvent Event>
+    constexpr TypeDescriptor::HookFunction HookOf() {
+        if constexpr (HasLifecycleHook<T, DynamicInstanceHost, Event>) return &Hook<T, Event>;
+        else return nullptr;
+    }
+
+    template <typename TRolesList>
+    struct RoleMaskOf;
+    template <typename... TRoles>
+    struct RoleMaskOf<TypeList<TRoles...>> {
+        static TypeMask<> Build() {
+            TypeMask<> Mask;
+            (Mask.Set(RoleIndex<TRoles>()), ...);
+            return Mask;
+        }
+    };
+
+    template <typename T>
+    TypeDescriptor MakeDescriptor() {
+        constexpr bool IsRole = std::is_base_of_v<Role, T>;
+        TypeDescriptor Descriptor{ TypeId<T>, 0, SchemaNameOf<T>(), sizeof(T), alignof(T), IsRole, {}, {},
+                                   &Construct<T>, &Relocate<T>, &Destroy<T>, nullptr, nullptr, nullptr, nullptr };
+        if constexpr (IsRole) {
+            Descriptor.Index = RoleIndex<T>();
+            Descriptor.RequiredAttributes = TypeMaskOf<typename T::RequiredAttributes>::Build();
+            Descriptor.RequiredRoles = RoleMaskOf<RoleClosure<typename T::RequiredRoles>>::Build();
+            if constexpr (HasDynamicUpdate<T>) Descriptor.Update = &Update<T>;
+            Descriptor.OnCreate = HookOf<T, LifecycleEvent::Create>();
+            Descriptor.OnEnable = HookOf<T, LifecycleEvent::Enable>();
+            Descriptor.OnDestroy = HookOf<T, LifecycleEvent::Destroy>();
+        } else {
+            Descriptor.Index = AttributeIndex<T>();
+        }
+        return Descriptor;
+    }
+
+    struct AlignedDelete {
+        std::size_t Alignment;
+        void operator()(std::byte* Block) const { ::operator delete(Block, std::align_val_t(Alignment)); }
+    };
+    using AlignedBlock = std::unique_ptr<std::byte[], AlignedDelete>;
+
+    inline AlignedBlock AllocateAligned(std::size_t Bytes, std::size_t Alignment) {
+        return AlignedBlock(static_cast<std::byte*>(::operator new(Bytes, std::align_val_t(Alignment))), AlignedDelete{ Alignment });
+    }
+} // namespace DynamicDetail
+
+// The descriptor of an Attribute or Role type, built on first use.
+template <typename T>
+const TypeDescriptor& DescriptorOf() {
+    static_assert(std::is_base_of_v<Attribute, T> || std::is_base_of_v<Role, T>,
+        "TypeDescriptor Error: Only Attributes and Roles can be described.");
+    static_assert(std::is_default_constructible_v<T>,
+        "TypeDescriptor Error: Dynamic Compositions value-initialize their members, so the type needs a default constructor.");
+    static const TypeDescriptor Descriptor = DynamicDetail::MakeDescriptor<T>();
+    return Descriptor;
+}
+
+// The types data may refer to, by SchemaNameOf<T>().
+class TypeCatalog {
+public:
+    template <typename T>
+    const TypeDescriptor& Register() {
+        const TypeDescriptor& Descriptor = DescriptorOf<T>();
+        (Descriptor.IsRole ? Roles : Attributes)[Descriptor.Name] = &Descriptor;
+        return Descriptor;
+    }
+
+    const TypeDescriptor* FindAttribute(std::string_view Name) const { return Find(Attributes, Name); }
+    const TypeDescriptor* FindRole(std::string_view Name) const { return Find(Roles, Name); }
+
+private:
+    using Table = std::unordered_map<std::string_view, const TypeDescriptor*>;
+
+    static const TypeDescriptor* Find(const Table& From, std::string_view Name) {
+        const auto Found = From.find(Name);
+        return Found == From.end() ? nullptr : Found->second;
+    }
+
+    Table Attributes;
+    Table Roles;
+};
+
+// A Composition type defined at run time. Immutable once built, and shared by
+// every pool of that type.
+class DynamicComposition {
+public:
+    static constexpr std::size_t ColumnAlignment = 64; // Matches CompositionPool.
+    static constexpr std::uint32_t Absent = ~std::uint32_t(0);
+
+    const std::string& Name() const { return TypeName; }
+    std::size_t ChunkCapacity() const { return Capacity; }
+    std::size_t ChunkBytes() const { return Bytes; }
+    std::size_t ChunkAlignment() const { return Alignment; }
+
+    std::size_t AttributeCount() const { return Columns.size(); }
+    const TypeDescriptor& AttributeAt(std::size_t Column) const { return *Columns[Column]; }
+    std::size_t ColumnOffset(std::size_t Column) const { return Offsets[Column]; }
+    std::span<const TypeDescriptor* const> Roles() const { return RoleTypes; }
+    const AttributeMask& Signature() const { return AttributeSignature; }
+
+    // The column holding the Attribute with this dense index, or Absent.
+    std::uint32_t ColumnOf(std::uint32_t AttributeIndex) const {
+        return AttributeIndex < ColumnByAttribute.size() ? ColumnByAttribute[AttributeIndex] : Absent;
+    }
+
+private:
+    friend struct DynamicCompositionResult BuildDynamicComposition(const TypeCatalog&, std::string, const std::vector<std::string>&,
+                                                                   const std::vector<std::string>&, std::size_t);
+
+    std::string TypeName;
+    std::size_t Capacity = 0;
+    std::size_t Bytes = 0;
+    std::size_t Alignment = ColumnAlignment;
+    std::vector<const TypeDescriptor*> Columns;
+    std::vector<std::size_t> Offsets;
+    std::vector<const TypeDescriptor*> RoleTypes;
+    std::vector<std::uint32_t> ColumnByAttribute;
+    AttributeMask AttributeSignature;
+};
+
+struct DynamicCompositionResult {
+    bool Ok = false;
+    std::shared_ptr<const DynamicComposition> Type;
+    std::string Error;
+};
+
+// Assembles a type from catalog names. Attributes are laid out in the order
+// given, so listing a static Composition's Attributes in its order yields
+// chunks identical to its CompositionPool's.
+inline DynamicCompositionResult BuildDynamicComposition(const TypeCatalog& Catalog, std::string Name,
+                                                        const std::vector<std::string>& AttributeNames,
+                                                        const std::vector<std::string>& RoleNames,
+                                                        std::size_t ChunkCapacity = 256) {
+    DynamicCompositionResult Result;
+    const auto Fail = [&](std::string Message) {
+        Result.Error = Name + ": " + std::move(Message);
+        return Result;
+    };
+    if (AttributeNames.empty()) return Fail("a pooled Composition needs at least one Attribute");
+    if (ChunkCapacity == 0) return Fail("ChunkCapacity must be non-zero");
+
+    auto Type = std::make_shared<DynamicComposition>();
+    TypeMask<> RoleSignature;
+    for (const std::string& AttributeName : AttributeNames) {
+        const TypeDescriptor* Descriptor = Catalog.FindAttribute(AttributeName);
+        if (!Descriptor) return Fail("unknown Attribute '" + AttributeName + "'");
+        if (Descriptor->Index >= AttributeMask::Capacity) return Fail("Attribute '" + AttributeName + "' has a dense index past AttributeMask::Capacity");
+        if (Type->AttributeSignature.Test(Descriptor->Index)) return Fail("Attribute '" + AttributeName + "' is listed more than once");
+        Type->AttributeSignature.Set(Descriptor->Index);
+        Type->Columns.push_back(Descriptor);
+    }
+    for (const std::string& RoleName : RoleNames) {
+        const TypeDescriptor* Descriptor = Catalog.FindRole(RoleName);
+        if (!Descriptor) return Fail("unknown Role '" + RoleName + "'");
+        if (Descriptor->Index >= TypeMask<>::Capacity) return Fail("Role '" + RoleName + "' has a dense index past TypeMask<>::Capacity");
+        if (RoleSignature.Test(Descriptor->Index)) return Fail("Role '" + RoleName + "' is listed more than once");
+        RoleSignature.Set(Descriptor->Index);
+        Type->RoleTypes.push_back(Descriptor);
+    }
+
+    // The run-time form of the Composition's DependenciesMet and closure checks.
+    for (const TypeDescriptor* Descriptor : Type->RoleTypes) {
+        if (!Type->AttributeSignature.ContainsAll(Descriptor->RequiredAttributes)) {
+            const TypeRegistry<Attribute>& Registry = TypeRegistry<Attribute>::Get();
+            const std::size_t Known = std::min<std::size_t>(Registry.Count(), AttributeMask::Capacity);
+            for (std::uint32_t Index = 0; Index < Known; ++Index) {
+                if (Descriptor->RequiredAttributes.Test(Index) && !Type->AttributeSignature.Test(Index)) {
+                    return Fail("Role '" + std::string(Descriptor->Name) + "' requires Attribute '" + std::string(Registry.At(Index).Name) + "'");
+                }
+            }
+        }
+        if (!RoleSignature.ContainsAll(Descriptor->RequiredRoles)) {
+            const TypeRegistry<Role>& Registry = TypeRegistry<Role>::Get();
+            const std::size_t Known = std::min<std::size_t>(Registry.Count(), TypeMask<>::Capacity);
+            for (std::uint32_t Index = 0; Index < Known; ++Index) {
+                if (Descriptor->RequiredRoles.Test(Index) && !RoleSignature.Test(Index)) {
+                    return Fail("Role '" + std::string(Descriptor->Name) + "' requires Role '" + std::string(Registry.At(Index).Name) + "'");
+                }
+            }
+        }
+    }
+
+    const std::size_t Count = Type->Columns.size();
+    std::vector<std::size_t> Sizes(Count), Alignments(Count);
+    std::uint32_t HighestIndex = 0;
+    for (std::size_t Column = 0; Column < Count; ++Column) {
+        Sizes[Column] = Type->Columns[Column]->Size;
+        Alignments[Column] = Type->Columns[Column]->Alignment;
+        Type->Alignment = std::max(Type->Alignment, Alignments[Column]);
+        HighestIndex = std::max(HighestIndex, Type->Columns[Column]->Index);
+    }
+    Type->Offsets.resize(Count);
+    Type->Bytes = CompositionPoolDetail::LayOutColumns(Sizes.data(), Alignments.data(), Count, ChunkCapacity,
+                                                       DynamicComposition::ColumnAlignment, Type->Offsets.data());
+    Type->ColumnByAttribute.assign(HighestIndex + 1, DynamicComposition::Absent);
+    for (std::size_t Column = 0; Column < Count; ++Column) Type->ColumnByAttribute[Type->Columns[Column]->Index] = static_cast<std::uint32_t>(Column);
+
+    Type->TypeName = std::move(Name);
+    Type->Capacity = ChunkCapacity;
+    Result.Ok = true;
+    Result.Type = std::move(Type);
+    return Result;
+}
+
+template <typename T>
+bool DynamicInstanceHost::HasAttribute() const {
+    return Chunk->Type->ColumnOf(AttributeIndex<T>()) != DynamicComposition::Absent;
+}
+
+template <typename T>
+T& DynamicInstanceHost::Attribute() const {
+    const std::uint32_t Column = Chunk->Type->ColumnOf(AttributeIndex<T>());
+    assert(Column != DynamicComposition::Absent && "DynamicInstanceHost Error: The Composition has no such Attribute; check HasAttribute() first.");
+    const std::size_t Offset = Chunk->Type->ColumnOffset(Column);
+    return std::launder(reinterpret_cast<T*>(Chunk->Data + Offset))[Slot];
+}
+
+// Instances of one DynamicComposition, densely packed in chunks like a
+// CompositionPool. Each pool keeps one shared instance of every Role, like
+// the pool's lifecycle hooks do. Spawning runs OnCreate then OnEnable a chunk
+// range at a time, and despawning or Clear() runs OnDestroy, Roles in reverse
+// order; destroying the pool itself runs no hooks.
+class DynamicPool {
+public:
+    explicit DynamicPool(std::shared_ptr<const DynamicComposition> InType) : Definition(std::move(InType)) {
+        for (const TypeDescriptor* Descriptor : Definition->Roles()) {
+            RoleStates.push_back(DynamicDetail::AllocateAligned(Descriptor->Size, std::max(Descriptor->Alignment, alignof(std::max_align_t))));
+            Descriptor->Construct(RoleStates.back().get(), 1);
+        }
+    }
+    DynamicPool(const DynamicPool&) = delete;
+    DynamicPool& operator=(const DynamicPool&) = delete;
+
+    ~DynamicPool() {
+        DestroyChunks();
+        const auto RoleTypes = Definition->Roles();
+        for (std::size_t Index = 0; Index < RoleTypes.size(); ++Index) RoleTypes[Index]->Destroy(RoleStates[Index].get(), 1);
+    }
+
+    const DynamicComposition& Type() const { return *Definition; }
+
+    // --- Instances ---
+    std::size_t Spawn() { return SpawnDefault(1); }
+
+    // Appends Count value-initialized instances, runs their OnCreate and
+    // OnEnable hooks, and returns the first index.
+    std::size_t SpawnDefault(std::size_t Count) {
+        const std::size_t First = InstanceCount;
+        const std::size_t Capacity = Definition->ChunkCapacity();
+        while (Count > 0) {
+            const std::size_t ChunkIndex = InstanceCount / Capacity;
+            if (ChunkIndex == Chunks.size()) Chunks.push_back({ DynamicDetail::AllocateAligned(Definition->ChunkBytes(), Definition->ChunkAlignment()), 0 });
+            Chunk& Target = Chunks[ChunkIndex];
+            const std::uint32_t Added = static_cast<std::uint32_t>(std::min<std::size_t>(Count, Capacity - Target.Count));
+            for (std::size_t Column = 0; Column < Definition->AttributeCount(); ++Column) {
+                Definition->AttributeAt(Column).Construct(Address(Target, Column, Target.Count), Added);
+            }
+            Target.Count += Added;
+            InstanceCount += Added;
+            Count -= Added;
+        }
+        for (std::size_t Next = First; Next < InstanceCount;) {
+            const std::size_t ChunkIndex = Next / Capacity;
+            const std::uint32_t From = static_cast<std::uint32_t>(Next % Capacity);
+            const std::uint32_t To = Chunks[ChunkIndex].Count;
+            RunHooks(&TypeDescriptor::OnCreate, ChunkIndex, From, To);
+            RunHooks(&TypeDescriptor::OnEnable, ChunkIndex, From, To);
+            Next += To - From;
+        }
+        return First;
+    }
+
+    // Removes an instance by relocating the last instance into its slot.
+    void Despawn(std::size_t Index) {
+        const std::size_t Capacity = Definition->ChunkCapacity();
+        const std::size_t Last = InstanceCount - 1;
+        RunHooks(&TypeDescriptor::OnDestroy, Index / Capacity, static_cast<std::uint32_t>(Index % Capacity), static_cast<std::uint32_t>(Index % Capacity) + 1);
+        Chunk& Hole = Chunks[Index / Capacity];
+        Chunk& Tail = Chunks[Last / Capacity];
+        for (std::size_t Column = 0; Column < Definition->AttributeCount(); ++Column) {
+            const TypeDescriptor& Descriptor = Definition->AttributeAt(Column);
+            void* Removed = Address(Hole, Column, Index % Capacity);
+            Descriptor.Destroy(Removed, 1);
+            if (Index != Last) Descriptor.Relocate(Removed, Address(Tail, Column, Last % Capacity), 1);
+        }
+        if (--Tail.Count == 0) Chunks.pop_back();
+        --InstanceCount;
+    }
+
+    // Despawns every instance, running OnDestroy a chunk at a time.
+    void Clear() {
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Chunks.size(); ++ChunkIndex) RunHooks(&TypeDescriptor::OnDestroy, ChunkIndex, 0, Chunks[ChunkIndex].Count);
+        DestroyChunks();
+    }
+
+    std::size_t Size() const { return InstanceCount; }
+
+    template <typename T>
+    T& Attribute(std::size_t Index) {
+        const std::size_t Capacity = Definition->ChunkCapacity();
+        return Column<T>(Index / Capacity)[Index % Capacity];
+    }
+
+    // --- Chunks ---
+    std::size_t ChunkCount() const { return Chunks.size(); }
+    std::uint32_t ChunkSize(std::size_t ChunkIndex) const { return Chunks[ChunkIndex].Count; }
+
+    std::byte* ColumnBytes(std::size_t ChunkIndex, std::size_t Column) { return Chunks[ChunkIndex].Data.get() + Definition->ColumnOffset(Column); }
+    const std::byte* ColumnBytes(std::size_t ChunkIndex, std::size_t Column) const { return Chunks[ChunkIndex].Data.get() + Definition->ColumnOffset(Column); }
+
+    // The column of T in a chunk, or null if this type has no T.
+    template <typename T>
+    T* Column(std::size_t ChunkIndex) {
+        const std::uint32_t Found = Definition->ColumnOf(AttributeIndex<T>());
+        return Found == DynamicComposition::Absent ? nullptr : std::launder(reinterpret_cast<T*>(ColumnBytes(ChunkIndex, Found)));
+    }
+
+    // Runs every Role's Update() over every chunk: one indirect call per Role
+    // per chunk, with all Roles applied to a chunk while it is in cache.
+    void Update(float DeltaTime) {
+        const auto RoleTypes = Definition->Roles();
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Chunks.size(); ++ChunkIndex) {
+            const DynamicChunkView View{ Definition.get(), Chunks[ChunkIndex].Data.get(), Chunks[ChunkIndex].Count, ChunkIndex * Definition->ChunkCapacity() };
+            for (std::size_t Index = 0; Index < RoleTypes.size(); ++Index) {
+                if (RoleTypes[Index]->Update) RoleTypes[Index]->Update(RoleStates[Index].get(), View, DeltaTime);
+            }
+        }
+    }
+
+private:
+    struct Chunk {
+        DynamicDetail::AlignedBlock Data;
+        std::uint32_t Count;
+    };
+
+    // Calls one hook of every Role that has it over slots [From, To) of a
+    // chunk. OnDestroy goes in reverse Role order.
+    void RunHooks(TypeDescriptor::HookFunction TypeDescriptor::*Hook, std::size_t ChunkIndex, std::uint32_t From, std::uint32_t To) {
+        const auto RoleTypes = Definition->Roles();
+        const DynamicChunkView View{ Definition.get(), Chunks[ChunkIndex].Data.get(), Chunks[ChunkIndex].Count, ChunkIndex * Definition->ChunkCapacity() };
+        const bool Reverse = Hook == &TypeDescriptor::OnDestroy;
+        for (std::size_t Step = 0; Step < RoleTypes.size(); ++Step) {
+            const std::size_t Index = Reverse ? RoleTypes.size() - 1 - Step : Step;
+            if (const TypeDescriptor::HookFunction Function = RoleTypes[Index]->*Hook) Function(RoleStates[Index].get(), View, From, To);
+        }
+    }
+
+    void DestroyChunks() {
+        for (Chunk& Target : Chunks) {
+            for (std::size_t Column = 0; Column < Definition->AttributeCount(); ++Column) {
+                Definition->AttributeAt(Column).Destroy(Address(Target, Column, 0), Target.Count);
+            }
+        }
+        Chunks.clear();
+        InstanceCount = 0;
+    }
+
+    std::byte* Address(Chunk& Target, std::size_t Column, std::size_t Slot) const {
+        return Target.Data.get() + Definition->ColumnOffset(Column) + Slot * Definition->AttributeAt(Column).Size;
+    }
+
+    std::shared_ptr<const DynamicComposition> Definition;
+    std::vector<Chunk> Chunks;
+    std::vector<DynamicDetail::AlignedBlock> RoleStates;
+    std::size_t InstanceCount = 0;
+};
+
+// --- Queries Across Pools ---
+// A pool of either kind reduced to what a query needs: which Attributes it
+// has, and where a column of a chunk lives. Column() stamps the column for
+// change tracking when Write is set.
+struct ArchetypeSource {
+    const AttributeMask* Signature = nullptr;
+    void* Pool = nullptr;
+    std::size_t (*ChunkCount)(const void* Pool) = nullptr;
+    std::uint32_t (*ChunkSize)(const void* Pool, std::size_t ChunkIndex) = nullptr;
+    std::byte* (*Column)(void* Pool, std::size_t ChunkIndex, std::uint32_t AttributeIndex, bool Write) = nullptr;
+};
+
+namespace DynamicDetail {
+    template <typename TPool>
+    std::byte* PoolColumn(void* Pool, std::size_t ChunkIndex, std::uint32_t Index, bool Write) {
+        static const std::vector<std::uint32_t> ColumnByAttribute = []<std::size_t... I>(std::index_sequence<I...>) {
+            const std::uint32_t Indices[] = { AttributeIndex<typename TPool::template AttributeAt<I>>()... };
+            std::vector<std::uint32_t> Table(*std::max_element(std::begin(Indices), std::end(Indices)) + 1, 0);
+            for (std::uint32_t Column = 0; Column < sizeof...(I); ++Column) Table[Indices[Column]] = Column;
+            return Table;
+        }(std::make_index_sequence<TPool::AttributeCount>{});
+        TPool& Typed = *static_cast<TPool*>(Pool);
+        const std::size_t Column = ColumnByAttribute[Index]; // The signature test guarantees the Attribute exists.
+        return Write ? Typed.MutableColumnBytes(ChunkIndex, Column) : const_cast<std::byte*>(Typed.ColumnBytes(ChunkIndex, Column));
+    }
+} // namespace DynamicDetail
+
+template <typename TComposition, std::size_t ChunkCapacity, typename TAttributesList>
+ArchetypeSource SourceOf(CompositionPool<TComposition, ChunkCapacity, TAttributesList>& Pool) {
+    using TPool = CompositionPool<TComposition, ChunkCapacity, TAttributesList>;
+    return { &AttributeSignatureOf<TComposition>(), &Pool,
+             [](const void* Erased) { return static_cast<const TPool*>(Erased)->ChunkCount(); },
+             [](const void* Erased, std::size_t ChunkIndex) { return static_cast<const TPool*>(Erased)->ChunkSize(ChunkIndex); },
+             &DynamicDetail::PoolColumn<TPool> };
+}
+
+inline ArchetypeSource SourceOf(DynamicPool& Pool) {
+    return { &Pool.Type().Signature(), &Pool,
+             [](const void* Erased) { return static_cast<const DynamicPool*>(Erased)->ChunkCount(); },
+             [](const void* Erased, std::size_t ChunkIndex) { return static_cast<const DynamicPool*>(Erased)->ChunkSize(ChunkIndex); },
+             [](void* Erased, std::size_t ChunkIndex, std::uint32_t Index, bool) {
+                 DynamicPool& Typed = *static_cast<DynamicPool*>(Erased);
+                 return Typed.ColumnBytes(ChunkIndex, Typed.Type().ColumnOf(Index));
+             } };
+}
+
+// Calls Function(Count, Ts*...) for every chunk of every source that has all
+// of Ts. Column pointers are resolved once per chunk, so the body is a plain
+// loop over arrays whichever kind of pool they came from. Declaring a type
+// const skips its change stamp.
+template <typename... Ts, typename TFunction>
+void ForEachChunk(std::span<const ArchetypeSource> Sources, TFunction&& Function) {
+    static const AttributeMask Query = TypeMaskOf<TypeList<std::remove_const_t<Ts>...>>::Build();
+    for (const ArchetypeSource& Source : Sources) {
+        if (!Source.Signature->ContainsAll(Query)) continue;
+        const std::size_t Chunks = Source.ChunkCount(Source.Pool);
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Chunks; ++ChunkIndex) {
+            const std::uint32_t Count = Source.ChunkSize(Source.Pool, ChunkIndex);
+            if (Count == 0) continue;
+            Function(Count, std::launder(reinterpret_cast<Ts*>(
+                Source.Column(Source.Pool, ChunkIndex, AttributeIndex<std::remove_const_t<Ts>>(), !std::is_const_v<Ts>)))...);
+        }
+    }
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef DYNAMIC_COMPOSITION_ENABLE_EXAMPLES
+
+#include <chrono>
+
+struct Transform : public Attribute {
+    static constexpr const char* SchemaName = "Transform";
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Velocity : public Attribute {
+    static constexpr const char* SchemaName = "Velocity";
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Health : public Attribute {
+    static constexpr const char* SchemaName = "Health";
+    int Points = 100;
+};
+
+class Mover : public Role {
+public:
+    static constexpr const char* SchemaName = "Mover";
+    using RequiredAttributes = TypeList<Transform, Velocity>;
+    template <typename HostType>
+    void Update(HostType& InHost, float DeltaTime) {
+        const Velocity& Speed = InHost.template Attribute<Velocity>();
+        InHost.template Attribute<Transform>().X += Speed.X * DeltaTime;
+    }
+};
+
+// Counts live instances through its lifecycle hooks.
+class Tracker : public Role {
+public:
+    static constexpr const char* SchemaName = "Tracker";
+    static inline int Live = 0;
+    template <typename HostType>
+    void OnCreate(HostType&) { ++Live; }
+    template <typename HostType>
+    void OnDestroy(HostType&) { --Live; }
+};
+
+class Soldier : public Composition<Soldier, TypeList<Mover>, TypeList<Transform, Velocity, Health>> {};
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    using Micro = std::chrono::microseconds;
+
+    TypeCatalog Catalog;
+    Catalog.Register<Transform>();
+    Catalog.Register<Velocity>();
+    Catalog.Register<Health>();
+    Catalog.Register<Mover>();
+    Catalog.Register<Tracker>();
+
+    // As read from a mod's data files.
+    const DynamicCompositionResult Drone = BuildDynamicComposition(Catalog, "Drone", { "Transform", "Velocity" }, { "Mover", "Tracker" });
+    const DynamicCompositionResult Turret = BuildDynamicComposition(Catalog, "Turret", { "Health" }, { "Mover" });
+    std::cout << "Turret rejected: " << Turret.Error << "\n";
+
+    // Same Attributes in the same order as a static pool: same chunk layout.
+    const DynamicCompositionResult Mirror = BuildDynamicComposition(Catalog, "Soldier", { "Transform", "Velocity", "Health" }, { "Mover" });
+    using SoldierPool = CompositionPool<Soldier>;
+    const bool SameLayout = Mirror.Type->ChunkBytes() == SoldierPool::ChunkBytes
+        && Mirror.Type->ColumnOffset(1) == SoldierPool::ColumnOffsets[1] && Mirror.Type->ColumnOffset(2) == SoldierPool::ColumnOffsets[2];
+    std::cout << "Dynamic Soldier chunks match the static pool: " << (SameLayout ? "yes" : "no") << "\n";
+
+    SoldierPool Soldiers;
+    for (int Index = 0; Index < 50000; ++Index) Soldiers.Spawn(Transform{}, Velocity{{}, 1.0f, 0.0f, 0.0f}, Health{});
+    DynamicPool Drones(Drone.Type);
+    Drones.SpawnDefault(50000);
+    for (std::size_t ChunkIndex = 0; ChunkIndex < Drones.ChunkCount(); ++ChunkIndex) {
+        Velocity* Speeds = Drones.Column<Velocity>(ChunkIndex);
+        for (std::uint32_t Slot = 0; Slot < Drones.ChunkSize(ChunkIndex); ++Slot) Speeds[Slot].X = 2.0f;
+    }
+    Drones.Despawn(0);
+    std::cout << "Drones tracked by hooks: " << Tracker::Live << " of " << Drones.Size() << "\n";
+
+    // Role updates through the descriptor table: one call per chunk.
+    auto Start = Clock::now();
+    Drones.Update(0.5f);
+    const auto UpdateTime = std::chrono::duration_cast<Micro>(Clock::now() - Start).count();
+
+    // One query over both kinds of pool.
+    const ArchetypeSource Sources[] = { SourceOf(Soldiers), SourceOf(Drones) };
+    std::size_t Moved = 0;
+    Start = Clock::now();
+    ForEachChunk<Transform, const Velocity>(Sources, [&](std::uint32_t Count, Transform* Positions, const Velocity* Speeds) {
+        for (std::uint32_t Slot = 0; Slot < Count; ++Slot) Positions[Slot].X += Speeds[Slot].X * 0.5f;
+        Moved += Count;
+    });
+    const auto QueryTime = std::chrono::duration_cast<Micro>(Clock::now() - Start).count();
+
+    std::cout << "Drone update: " << Drones.Size() << " instances in " << UpdateTime << " us\n"
+              << "Query moved " << Moved << " soldiers and drones in " << QueryTime << " us: soldier 0 at X="
+              << Soldiers.Attribute<Transform>(0).X << ", drone 0 at X=" << Drones.Attribute<Transform>(0).X << std::endl;
+    return 0;
+}
+
+#endif // DYNAMIC_COMPOSITION_ENABLE_EXAMPLES
+
+#endif // DYNAMIC_COMPOSITION_CPP
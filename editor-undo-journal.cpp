@@ -0,0 +1,260 @@
+#ifndef EDITOR_UNDO_JOURNAL_CPP
+#define EDITOR_UNDO_JOURNAL_CPP
+
+#include "attribute-serialization.cpp"
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <span>
+#include <string>
+#include <vector>
+
+// --- Tier 6: Editor Undo Journal ---
+// Editor tools change Attributes through the journal instead of writing to the
+// pool directly. For every edit it keeps only the Attribute that was touched,
+// as a before and after value, and drops edits that left the value unchanged.
+// Edits between BeginAction() and EndAction() form one undo step, and
+// consecutive edits to the same Attribute share one batch (index list plus
+// packed before/after values). Undoing a bulk edit of thousands of objects is
+// therefore a single tight scatter over the pool columns.
+//
+// Trivially copyable Attributes are stored as raw bytes, the rest through their
+// reflected fields. Once the journal exceeds its memory budget the oldest
+// actions are forgotten.
+//
+// Entries refer to instances by pool index, which Spawn() and Despawn() can
+// change. The journal records the pool size with each action and refuses to
+// apply one recorded at a different size; call Clear() after structural edits.
+
+template <typename TPool>
+class EditJournal {
+public:
+    explicit EditJournal(TPool& InPool, std::size_t InMemoryBudget = std::size_t(64) << 20)
+        : Pool(InPool), MemoryBudget(InMemoryBudget) {}
+
+    // Opens an undo step. Nested calls join the outermost action.
+    void BeginAction(std::string Name) {
+        if (Depth++ == 0) Open = { std::move(Name), {}, 0, Pool.Size() };
+    }
+
+    void EndAction() {
+        if (Depth == 0 || --Depth > 0) return;
+        if (Open.Batches.empty()) return;
+        RedoStack.clear();
+        UndoStack.push_back(std::move(Open));
+        Open = {};
+        Trim();
+    }
+
+    // Calls Edit(T&) on one instance's Attribute and records the change.
+    template <typename T, typename TEdit>
+    void Modify(std::size_t Index, TEdit&& Edit) {
+        ModifyMany<T>(std::span<const std::size_t>(&Index, 1), Edit);
+    }
+
+    // Calls Edit(T&) on every listed instance as one batch.
+    template <typename T, typename TEdit>
+    void ModifyMany(std::span<const std::size_t> Indices, TEdit&& Edit) {
+        const bool Implicit = Depth == 0;
+        if (Implicit) BeginAction(std::string(SchemaNameOf<T>()));
+
+        constexpr std::uint32_t Column = static_cast<std::uint32_t>(TPool::template ColumnIndex<T>);
+        if (Open.Batches.empty() || Open.Batches.back().Column != Column) Open.Batches.push_back({ Column, {}, {}, {} });
+        Batch& Target = Open.Batches.back();
+        const std::size_t BytesBefore = BatchBytes(Target);
+
+        std::vector<std::byte> Before, After;
+        for (const std::size_t Index : Indices) {
+            T& Value = Pool.template Attribute<T>(Index);
+            Before.clear();
+            After.clear();
+            Store(Before, Value);
+            Edit(Value);
+            Store(After, Value);
+            if (Before == After) continue;
+            Target.Indices.push_back(static_cast<std::uint32_t>(Index));
+            Target.Before.insert(Target.Before.end(), Before.begin(), Before.end());
+            Target.After.insert(Target.After.end(), After.begin(), After.end());
+        }
+        Open.Bytes += BatchBytes(Target) - BytesBefore;
+        if (Target.Indices.empty()) Open.Batches.pop_back();
+
+        if (Implicit) EndAction();
+    }
+
+    // Reverts the newest action. Fails if an action is open or the pool size
+    // no longer matches the one it was recorded at.
+    bool Undo() {
+        if (Depth > 0 || UndoStack.empty() || UndoStack.back().PoolSize != Pool.Size()) return false;
+        const Action& Last = UndoStack.back();
+        for (auto Entry = Last.Batches.rbegin(); Entry != Last.Batches.rend(); ++Entry) ApplyTable[Entry->Column](Pool, *Entry, false);
+        RedoStack.push_back(std::move(UndoStack.back()));
+        UndoStack.pop_back();
+        return true;
+    }
+
+    bool Redo() {
+        if (Depth > 0 || RedoStack.empty() || RedoStack.back().PoolSize != Pool.Size()) return false;
+        for (const Batch& Entry : RedoStack.back().Batches) ApplyTable[Entry.Column](Pool, Entry, true);
+        UndoStack.push_back(std::move(RedoStack.back()));
+        RedoStack.pop_back();
+        return true;
+    }
+
+    void Clear() {
+        UndoStack.clear();
+        RedoStack.clear();
+    }
+
+    bool CanUndo() const { return Depth == 0 && !UndoStack.empty(); }
+    bool CanRedo() const { return Depth == 0 && !RedoStack.empty(); }
+    const std::string& UndoName() const { return UndoStack.back().Name; }
+    const std::string& RedoName() const { return RedoStack.back().Name; }
+    std::size_t UndoCount() const { return UndoStack.size(); }
+
+    // Bytes held by recorded actions, the quantity bounded by MemoryBudget.
+    std::size_t MemoryBytes() const {
+        std::size_t Total = 0;
+        for (const Action& Entry : UndoStack) Total += Entry.Bytes;
+        for (const Action& Entry : RedoStack) Total += Entry.Bytes;
+        return Total;
+    }
+
+private:
+    struct Batch {
+        std::uint32_t Column;
+        std::vector<std::uint32_t> Indices;
+        std::vector<std::byte> Before;
+        std::vector<std::byte> After;
+    };
+    struct Action {
+        std::string Name;
+        std::vector<Batch> Batches;
+        std::size_t Bytes = 0;
+        std::size_t PoolSize = 0;
+    };
+
+    using ApplyFunction = void (*)(TPool&, const Batch&, bool);
+
+    static std::size_t BatchBytes(const Batch& Entry) {
+        return sizeof(Batch) + Entry.Indices.size() * sizeof(std::uint32_t) + Entry.Before.size() + Entry.After.size();
+    }
+
+    template <typename T>
+    static void Store(std::vector<std::byte>& Out, const T& Value) {
+        if constexpr (std::is_trivially_copyable_v<T>) SerializationDetail::AppendBytes(Out, &Value, sizeof(T));
+        else SerializationDetail::WriteFields(Out, Value);
+    }
+
+    // Writes a batch's Before (undo, newest first) or After (redo) values back.
+    template <std::size_t I>
+    static void Apply(TPool& Pool, const Batch& Entry, bool Forward) {
+        using T = typename TPool::template AttributeAt<I>;
+        const std::vector<std::byte>& Bytes = Forward ? Entry.After : Entry.Before;
+        const std::size_t Count = Entry.Indices.size();
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            for (std::size_t Step = 0; Step < Count; ++Step) {
+                const std::size_t Slot = Forward ? Step : Count - 1 - Step;
+                std::memcpy(static_cast<void*>(&Pool.template Attribute<T>(Entry.Indices[Slot])), Bytes.data() + Slot * sizeof(T), sizeof(T));
+            }
+        } else {
+            std::vector<T> Values(Count);
+            SerializationDetail::ByteReader Reader(Bytes);
+            for (T& Value : Values) SerializationDetail::ReadFields(Reader, Value);
+            for (std::size_t Step = 0; Step < Count; ++Step) {
+                const std::size_t Slot = Forward ? Step : Count - 1 - Step;
+                Pool.template Attribute<T>(Entry.Indices[Slot]) = std::move(Values[Slot]);
+            }
+        }
+    }
+
+    template <std::size_t... I>
+    static constexpr std::array<ApplyFunction, sizeof...(I)> MakeApplyTable(std::index_sequence<I...>) {
+        return { &Apply<I>... };
+    }
+
+    static constexpr auto ApplyTable = MakeApplyTable(std::make_index_sequence<TPool::AttributeCount>{});
+
+    // Forgets the oldest actions (redo entries first) until within budget.
+    void Trim() {
+        std::size_t Total = MemoryBytes();
+        while (Total > MemoryBudget && !RedoStack.empty()) {
+            Total -= RedoStack.front().Bytes;
+            RedoStack.pop_front();
+        }
+        while (Total > MemoryBudget && UndoStack.size() > 1) {
+            Total -= UndoStack.front().Bytes;
+            UndoStack.pop_front();
+        }
+    }
+
+    TPool& Pool;
+    std::size_t MemoryBudget;
+    std::deque<Action> UndoStack;
+    std::deque<Action> RedoStack;
+    Action Open;
+    int Depth = 0;
+};
+
+
+// --- EXAMPLE USAGE ---
+#ifdef UNDO_ENABLE_EXAMPLES
+
+#include <chrono>
+
+struct Transform : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Category : public Attribute {
+    std::string Name = "Default";
+};
+struct Lighting : public Attribute {
+    float Intensity = 1.0f;
+    float Range = 10.0f;
+    float Color[3] = { 1.0f, 1.0f, 1.0f };
+};
+
+class Lamp : public Composition<Lamp, TypeList<>, TypeList<Transform, Category, Lighting>> {};
+
+using LampPool = CompositionPool<Lamp>;
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    using Micro = std::chrono::microseconds;
+
+    LampPool Level;
+    for (int Index = 0; Index < 20000; ++Index) Level.Spawn(Transform{{}, float(Index), 0.0f, 0.0f}, Category{{}, "Street"}, Lighting{});
+    EditJournal<LampPool> Journal(Level);
+
+    // The designer selects every other lamp and lifts and retags it in one go.
+    std::vector<std::size_t> Selection;
+    for (std::size_t Index = 0; Index < Level.Size(); Index += 2) Selection.push_back(Index);
+    Journal.BeginAction("Raise and retag selection");
+    Journal.ModifyMany<Transform>(Selection, [](Transform& Value) { Value.Y += 5.0f; });
+    Journal.ModifyMany<Category>(Selection, [](Category& Value) { Value.Name = "Plaza"; });
+    Journal.ModifyMany<Lighting>(Selection, [](Lighting&) {}); // Unchanged, so not recorded.
+    Journal.EndAction();
+    Journal.Modify<Lighting>(0, [](Lighting& Value) { Value.Intensity = 3.0f; });
+
+    const std::size_t WholeObjects = Selection.size() * 2 * (sizeof(Transform) + sizeof(Category) + sizeof(Lighting));
+    std::cout << Journal.UndoCount() << " actions in " << Journal.MemoryBytes() << " bytes (copying whole objects: "
+              << WholeObjects << " bytes)\n";
+
+    Journal.Undo();
+    const auto Start = Clock::now();
+    const bool Undone = Journal.Undo();
+    const auto UndoTime = std::chrono::duration_cast<Micro>(Clock::now() - Start).count();
+    std::cout << "Undo '" << Journal.RedoName() << "' " << (Undone ? "took " : "failed after ") << UndoTime << " us: lamp 2 at Y="
+              << Level.Attribute<Transform>(2).Y << " tagged " << Level.Attribute<Category>(2).Name << "\n";
+
+    Journal.Redo();
+    Journal.Redo();
+    std::cout << "Redo both: lamp 2 at Y=" << Level.Attribute<Transform>(2).Y << " tagged " << Level.Attribute<Category>(2).Name
+              << ", lamp 0 intensity " << Level.Attribute<Lighting>(0).Intensity << std::endl;
+    return 0;
+}
+
+#endif // UNDO_ENABLE_EXAMPLES
+
+#endif // EDITOR_UNDO_JOURNAL_CPP
@@ -0,0 +1,357 @@
+#ifndef FIXED_POINT_TRANSFORM_CPP
+#define FIXED_POINT_TRANSFORM_CPP
+
+#include "composition-pool.cpp"
+#include "simd-transform-kernels.cpp"
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// --- Tier 4: Fixed-Point Transforms ---
+// Lockstep simulation needs every machine to compute the same bits. Float math
+// only does that with the optimizer's hands tied (no FMA contraction, no
+// reassociation, the same libm), globally. Fixed-point numbers are integers
+// underneath, and integer addition and multiplication give the same result on
+// every compiler and instruction set.
+//
+// Fixed<TRaw, FractionBits> is a signed binary fixed-point number. Q16_16
+// (32-bit, range +-32768, step 1/65536) suits gameplay positions; Q32_32
+// (64-bit) covers whole worlds at the same precision. Multiplication rounds
+// toward negative infinity and overflow wraps, identically everywhere.
+//
+// The scalar type is chosen per Composition: BasicTransform, BasicVelocity
+// and BasicMover take it as a parameter, so a lockstep unit lists
+// BasicMover<Q16_16> and a cosmetic particle BasicMover<float>, side by side.
+// IntegrateMovers() advances a whole pool. For Q16_16 it runs the integer
+// kernel picked by FixedKernels(), which produces the same bits at every
+// SimdLevel.
+
+namespace FixedDetail {
+    // Bits [Shift, Shift + 64) of the 128-bit product A * B, built from 32-bit
+    // halves so it needs no compiler-specific 128-bit type.
+    constexpr std::int64_t MultiplyShift(std::int64_t A, std::int64_t B, int Shift) {
+        const std::uint64_t UA = static_cast<std::uint64_t>(A), UB = static_cast<std::uint64_t>(B);
+        const std::uint64_t AL = UA & 0xFFFFFFFFu, AH = UA >> 32, BL = UB & 0xFFFFFFFFu, BH = UB >> 32;
+        const std::uint64_t LL = AL * BL, LH = AL * BH, HL = AH * BL, HH = AH * BH;
+        const std::uint64_t Middle = (LL >> 32) + (LH & 0xFFFFFFFFu) + (HL & 0xFFFFFFFFu);
+        const std::uint64_t Low = (Middle << 32) | (LL & 0xFFFFFFFFu);
+        std::uint64_t High = HH + (LH >> 32) + (HL >> 32) + (Middle >> 32);
+        // The unsigned product of the two's complement patterns, corrected to the signed one.
+        if (A < 0) High -= UB;
+        if (B < 0) High -= UA;
+        return static_cast<std::int64_t>(Shift == 0 ? Low : (High << (64 - Shift)) | (Low >> Shift));
+    }
+} // namespace FixedDetail
+
+template <typename TRaw, int FractionBits>
+class Fixed {
+public:
+    static_assert(std::is_same_v<TRaw, std::int32_t> || std::is_same_v<TRaw, std::int64_t>,
+        "Fixed Error: The raw type must be std::int32_t or std::int64_t.");
+    static_assert(FractionBits > 0 && FractionBits < int(sizeof(TRaw) * 8) - 1, "Fixed Error: FractionBits out of range.");
+
+    using RawType = TRaw;
+    static constexpr int Fraction = FractionBits;
+
+    constexpr Fixed() = default;
+
+    static constexpr Fixed FromRaw(TRaw Value) { return Fixed(Value); }
+    static constexpr Fixed FromInt(TRaw Value) { return Fixed(Wrap(static_cast<std::uint64_t>(Value) << FractionBits)); }
+    // Numerator / Denominator, rounded toward zero. The deterministic way to
+    // write constants such as FromRatio(1, 60). Numerator must stay within
+    // +-2^(63 - FractionBits).
+    static constexpr Fixed FromRatio(std::int64_t Numerator, std::int64_t Denominator) {
+        return Fixed(static_cast<TRaw>(Numerator * (std::int64_t(1) << FractionBits) / Denominator));
+    }
+    // Rounds to nearest. For tools and presentation only: the value depends
+    // on how the float was computed.
+    static constexpr Fixed FromDouble(double Value) {
+        const double Scaled = Value * double(std::uint64_t(1) << FractionBits);
+        return Fixed(static_cast<TRaw>(Scaled < 0.0 ? Scaled - 0.5 : Scaled + 0.5));
+    }
+
+    constexpr TRaw Raw() const { return Value; }
+    constexpr double ToDouble() const { return double(Value) / double(std::uint64_t(1) << FractionBits); }
+
+    friend constexpr Fixed operator+(Fixed A, Fixed B) { return Fixed(Wrap(std::uint64_t(A.Value) + std::uint64_t(B.Value))); }
+    friend constexpr Fixed operator-(Fixed A, Fixed B) { return Fixed(Wrap(std::uint64_t(A.Value) - std::uint64_t(B.Value))); }
+    friend constexpr Fixed operator-(Fixed A) { return Fixed(Wrap(0 - std::uint64_t(A.Value))); }
+    friend constexpr Fixed operator*(Fixed A, Fixed B) {
+        if constexpr (sizeof(TRaw) == 4) return Fixed(Wrap(static_cast<std::uint64_t>((std::int64_t(A.Value) * B.Value) >> FractionBits)));
+        else return Fixed(FixedDetail::MultiplyShift(A.Value, B.Value, FractionBits));
+    }
+
+    constexpr Fixed& operator+=(Fixed Other) { return *this = *this + Other; }
+    constexpr Fixed& operator-=(Fixed Other) { return *this = *this - Other; }
+    constexpr Fixed& operator*=(Fixed Other) { return *this = *this * Other; }
+
+    friend constexpr auto operator<=>(Fixed, Fixed) = default;
+
+private:
+    constexpr explicit Fixed(TRaw InValue) : Value(InValue) {}
+    static constexpr TRaw Wrap(std::uint64_t Bits) { return static_cast<TRaw>(Bits); }
+
+    TRaw Value = 0;
+};
+
+using Q16_16 = Fixed<std::int32_t, 16>;
+using Q32_32 = Fixed<std::int64_t, 32>;
+
+template <typename TScalar>
+struct BasicTransform : public Attribute {
+    TScalar X{}, Y{}, Z{};
+};
+
+template <typename TScalar>
+struct BasicVelocity : public Attribute {
+    TScalar X{}, Y{}, Z{};
+};
+
+// Mover over the scalar type the Composition picked.
+template <typename TScalar>
+class BasicMover : public Role {
+public:
+    using Scalar = TScalar;
+    using RequiredAttributes = TypeList<BasicTransform<TScalar>, BasicVelocity<TScalar>>;
+
+    template <typename HostType>
+    void MoveX(HostType& InHost, TScalar DeltaX) {
+        InHost.template Attribute<BasicTransform<TScalar>>().X += DeltaX;
+    }
+
+    // Position += Velocity * DeltaTime, per axis.
+    template <typename HostType>
+    void Update(HostType& InHost, TScalar DeltaTime) {
+        BasicTransform<TScalar>& Position = InHost.template Attribute<BasicTransform<TScalar>>();
+        const BasicVelocity<TScalar>& Speed = InHost.template Attribute<BasicVelocity<TScalar>>();
+        Position.X += Speed.X * DeltaTime;
+        Position.Y += Speed.Y * DeltaTime;
+        Position.Z += Speed.Z * DeltaTime;
+    }
+};
+
+using FixedTransform = BasicTransform<Q16_16>;
+using FixedVelocity  = BasicVelocity<Q16_16>;
+using FixedMover     = BasicMover<Q16_16>;
+
+static_assert(sizeof(FixedTransform) == 3 * sizeof(std::int32_t) && sizeof(FixedVelocity) == 3 * sizeof(std::int32_t),
+    "Fixed Error: The integer kernels read fixed-point Transforms as packed raw values.");
+
+// --- Integer Kernels ---
+// Count raw Q16.16 lanes: Positions[I] += Velocities[I] * DeltaTime. A column
+// of {X, Y, Z} structs is 3 * Count lanes, because every lane is scaled by the
+// same DeltaTime. Wide sets multiply even and odd lanes into 64-bit products
+// and keep bits 16..47, which is what the scalar code keeps too.
+struct FixedKernelTable {
+    SimdLevel Level;
+    void (*IntegrateQ16)(std::int32_t* Positions, const std::int32_t* Velocities, std::size_t Count, std::int32_t DeltaTime);
+};
+
+namespace FixedDetail {
+    inline void IntegrateQ16Scalar(std::int32_t* Positions, const std::int32_t* Velocities, std::size_t Count, std::int32_t DeltaTime,
+                                   std::size_t First = 0) {
+        for (std::size_t Index = First; Index < Count; ++Index) {
+            Positions[Index] = (Q16_16::FromRaw(Positions[Index]) + Q16_16::FromRaw(Velocities[Index]) * Q16_16::FromRaw(DeltaTime)).Raw();
+        }
+    }
+
+    inline void IntegrateQ16Default(std::int32_t* Positions, const std::int32_t* Velocities, std::size_t Count, std::int32_t DeltaTime) {
+        IntegrateQ16Scalar(Positions, Velocities, Count, DeltaTime);
+    }
+
+#ifdef SIMD_TRANSFORM_X86
+    // SSE2 only multiplies unsigned: like MultiplyShift, subtract the other
+    // operand from the high half of the product for each negative operand.
+    SIMD_TARGET("sse2") inline void IntegrateQ16SSE2(std::int32_t* Positions, const std::int32_t* Velocities, std::size_t Count,
+                                                     std::int32_t DeltaTime) {
+        const __m128i Scale = _mm_set1_epi32(DeltaTime);
+        const __m128i ScaleSign = _mm_srai_epi32(Scale, 31);
+        const __m128i High = _mm_set1_epi64x(static_cast<long long>(0xFFFFFFFF00000000ull));
+        std::size_t Index = 0;
+        for (; Index + 4 <= Count; Index += 4) {
+            const __m128i Speed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Velocities + Index));
+            const __m128i Correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(Speed, 31), Scale), _mm_and_si128(ScaleSign, Speed));
+            const __m128i Even = _mm_sub_epi64(_mm_mul_epu32(Speed, Scale), _mm_slli_epi64(Correction, 32));
+            const __m128i Odd = _mm_sub_epi64(_mm_mul_epu32(_mm_srli_epi64(Speed, 32), Scale), _mm_and_si128(Correction, High));
+            const __m128i Step = _mm_or_si128(_mm_andnot_si128(High, _mm_srli_epi64(Even, 16)), _mm_and_si128(High, _mm_slli_epi64(Odd, 16)));
+            __m128i* At = reinterpret_cast<__m128i*>(Positions + Index);
+            _mm_storeu_si128(At, _mm_add_epi32(_mm_loadu_si128(At), Step));
+        }
+        IntegrateQ16Scalar(Positions, Velocities, Count, DeltaTime, Index);
+    }
+
+    SIMD_TARGET("avx2") inline void IntegrateQ16AVX2(std::int32_t* Positions, const std::int32_t* Velocities, std::size_t Count,
+                                                     std::int32_t DeltaTime) {
+        const __m256i Scale = _mm256_set1_epi32(DeltaTime);
+        std::size_t Index = 0;
+        for (; Index + 8 <= Count; Index += 8) {
+            const __m256i Speed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Velocities + Index));
+            const __m256i Even = _mm256_srli_epi64(_mm256_mul_epi32(Speed, Scale), 16);
+            const __m256i Odd = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(Speed, 32), Scale), 16);
+            const __m256i Step = _mm256_blend_epi32(Even, Odd, 0xAA);
+            __m256i* At = reinterpret_cast<__m256i*>(Positions + Index);
+            _mm256_storeu_si256(At, _mm256_add_epi32(_mm256_loadu_si256(At), Step));
+        }
+        IntegrateQ16Scalar(Positions, Velocities, Count, DeltaTime, Index);
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // GCC 12 misreads the AVX-512 intrinsics' undefined registers.
+#endif
+    SIMD_TARGET("avx512f") inline void IntegrateQ16AVX512(std::int32_t* Positions, const std::int32_t* Velocities, std::size_t Count,
+                                                          std::int32_t DeltaTime) {
+        const __m512i Scale = _mm512_set1_epi32(DeltaTime);
+        std::size_t Index = 0;
+        for (; Index + 16 <= Count; Index += 16) {
+            const __m512i Speed = _mm512_loadu_si512(Velocities + Index);
+            const __m512i Even = _mm512_srli_epi64(_mm512_mul_epi32(Speed, Scale), 16);
+            const __m512i Odd = _mm512_slli_epi64(_mm512_mul_epi32(_mm512_srli_epi64(Speed, 32), Scale), 16);
+            const __m512i Step = _mm512_mask_blend_epi32(0xAAAA, Even, Odd);
+            _mm512_storeu_si512(Positions + Index, _mm512_add_epi32(_mm512_loadu_si512(Positions + Index), Step));
+        }
+        IntegrateQ16Scalar(Positions, Velocities, Count, DeltaTime, Index);
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif // SIMD_TRANSFORM_X86
+} // namespace FixedDetail
+
+// The kernels for Level.
+inline const FixedKernelTable& FixedKernelsFor(SimdLevel Level) {
+    using namespace FixedDetail;
+    static const FixedKernelTable Scalar{ SimdLevel::Scalar, &IntegrateQ16Default };
+#ifdef SIMD_TRANSFORM_X86
+    static const FixedKernelTable Sse2{ SimdLevel::SSE2, &IntegrateQ16SSE2 };
+    static const FixedKernelTable Avx2{ SimdLevel::AVX2, &IntegrateQ16AVX2 };
+    static const FixedKernelTable Avx512{ SimdLevel::AVX512, &IntegrateQ16AVX512 };
+    switch (Level) {
+        case SimdLevel::SSE2: return Sse2;
+        case SimdLevel::AVX2: return Avx2;
+        case SimdLevel::AVX512: return Avx512;
+        default: break;
+    }
+#endif
+    (void)Level;
+    return Scalar;
+}
+
+inline const FixedKernelTable& FixedKernels() {
+    static const FixedKernelTable& Best = FixedKernelsFor(DetectSimdLevel());
+    return Best;
+}
+
+// Runs BasicMover<TScalar>::Update over every instance of Pool, chunk by
+// chunk. Q16_16 pools go through the integer kernel; other scalar types run
+// the Role's math per instance.
+template <typename TPool, typename TScalar>
+void IntegrateMovers(TPool& Pool, TScalar DeltaTime, const FixedKernelTable& Kernels = FixedKernels()) {
+    using TransformType = BasicTransform<TScalar>;
+    using VelocityType = BasicVelocity<TScalar>;
+    static_assert(ContainsAll<typename TPool::CompositionType::AttributesList, TypeList<TransformType, VelocityType>>,
+        "Fixed Error: The pool does not store the Transform and Velocity of this scalar type.");
+
+    for (std::size_t ChunkIndex = 0; ChunkIndex < Pool.ChunkCount(); ++ChunkIndex) {
+        const std::uint32_t Count = Pool.ChunkSize(ChunkIndex);
+        if (Count == 0) continue;
+        const VelocityType* Speeds = Pool.template Column<VelocityType>(ChunkIndex);
+        TransformType* Positions = Pool.template MutableColumn<TransformType>(ChunkIndex);
+        if constexpr (std::is_same_v<TScalar, Q16_16>) {
+            Kernels.IntegrateQ16(reinterpret_cast<std::int32_t*>(Positions), reinterpret_cast<const std::int32_t*>(Speeds), Count * 3,
+                                 DeltaTime.Raw());
+        } else {
+            for (std::uint32_t Slot = 0; Slot < Count; ++Slot) {
+                Positions[Slot].X += Speeds[Slot].X * DeltaTime;
+                Positions[Slot].Y += Speeds[Slot].Y * DeltaTime;
+                Positions[Slot].Z += Speeds[Slot].Z * DeltaTime;
+            }
+        }
+    }
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef FIXED_POINT_ENABLE_EXAMPLES
+
+#include <chrono>
+#include <vector>
+
+static_assert((Q16_16::FromInt(3) * Q16_16::FromRatio(1, 2)).Raw() == Q16_16::FromRatio(3, 2).Raw());
+static_assert((Q32_32::FromInt(-3) * Q32_32::FromRatio(1, 4)).Raw() == Q32_32::FromRatio(-3, 4).Raw());
+static_assert((Q32_32::FromInt(1000000) * Q32_32::FromInt(-3)).Raw() == Q32_32::FromInt(-3000000).Raw());
+
+// Simulated in lockstep: every peer must agree on its position.
+class Unit : public Composition<Unit, TypeList<FixedMover>, TypeList<FixedTransform, FixedVelocity>> {
+public:
+    using Composition::Composition;
+};
+// Far-flung ships in Q32.32, and cosmetic debris that may differ between peers.
+class Ship : public Composition<Ship, TypeList<BasicMover<Q32_32>>, TypeList<BasicTransform<Q32_32>, BasicVelocity<Q32_32>>> {};
+class Debris : public Composition<Debris, TypeList<BasicMover<float>>, TypeList<BasicTransform<float>, BasicVelocity<float>>> {};
+
+using UnitPool = CompositionPool<Unit>;
+
+static std::uint64_t HashPosition(std::uint64_t Hash, const FixedTransform& Position) {
+    for (const Q16_16 Axis : { Position.X, Position.Y, Position.Z }) Hash = (Hash ^ static_cast<std::uint32_t>(Axis.Raw())) * 1099511628211ull;
+    return Hash;
+}
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    constexpr int Count = 100000, Frames = 600;
+    const Q16_16 Step = Q16_16::FromRatio(1, 60);
+
+    const auto Start = [](int Index) {
+        return Unit(std::piecewise_construct,
+                    InPlace<FixedTransform>(Q16_16::FromInt(Index % 1000 - 500), Q16_16{}, Q16_16::FromInt(Index / 1000)),
+                    InPlace<FixedVelocity>(Q16_16::FromRatio(Index % 37 - 18, 7), Q16_16::FromRatio(1, 3), Q16_16::FromRatio(-(Index % 11), 5)));
+    };
+
+    // The Role's math on standalone objects is the reference.
+    std::vector<Unit> Objects;
+    for (int Index = 0; Index < Count; ++Index) Objects.push_back(Start(Index));
+    auto Begin = Clock::now();
+    for (int Frame = 0; Frame < Frames; ++Frame) {
+        for (Unit& Object : Objects) Object.Role<FixedMover>().Update(Object, Step);
+    }
+    const auto ReferenceTime = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - Begin).count();
+    std::uint64_t Expected = 14695981039346656037ull;
+    for (const Unit& Object : Objects) Expected = HashPosition(Expected, Object.Attribute<FixedTransform>());
+    std::cout << "Per-object Role update: " << ReferenceTime << " ms, hash " << std::hex << Expected << std::dec << "\n";
+
+    const SimdLevel Best = DetectSimdLevel();
+    for (const SimdLevel Level : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 }) {
+        if (Level > Best) continue;
+        UnitPool Pool;
+        for (int Index = 0; Index < Count; ++Index) {
+            const Unit Object = Start(Index);
+            Pool.Spawn(Object.Attribute<FixedTransform>(), Object.Attribute<FixedVelocity>());
+        }
+        Begin = Clock::now();
+        for (int Frame = 0; Frame < Frames; ++Frame) IntegrateMovers(Pool, Step, FixedKernelsFor(Level));
+        const auto Time = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - Begin).count();
+        std::uint64_t Hash = 14695981039346656037ull;
+        for (std::size_t Index = 0; Index < Pool.Size(); ++Index) Hash = HashPosition(Hash, Pool.Attribute<FixedTransform>(Index));
+        std::cout << "IntegrateMovers " << SimdLevelName(Level) << ": " << Time << " ms, hash " << std::hex << Hash << std::dec
+                  << (Hash == Expected ? " (identical)" : " (DIFFERS)") << "\n";
+    }
+
+    CompositionPool<Ship> Ships;
+    Ships.Spawn(BasicTransform<Q32_32>{{}, Q32_32::FromInt(1000000000), Q32_32{}, Q32_32{}},
+                BasicVelocity<Q32_32>{{}, Q32_32::FromRatio(1, 1000), Q32_32{}, Q32_32{}});
+    for (int Frame = 0; Frame < 60; ++Frame) IntegrateMovers(Ships, Q32_32::FromRatio(1, 60));
+    CompositionPool<Debris> Pieces;
+    Pieces.Spawn(BasicTransform<float>{{}, 1000000000.0f, 0.0f, 0.0f}, BasicVelocity<float>{{}, 0.001f, 0.0f, 0.0f});
+    for (int Frame = 0; Frame < 60; ++Frame) IntegrateMovers(Pieces, 1.0f / 60.0f);
+    std::cout.precision(15);
+    std::cout << "After one second at 1 mm/s from 1e9: Q32.32 ship at " << Ships.Attribute<BasicTransform<Q32_32>>(0).X.ToDouble()
+              << ", float debris at " << Pieces.Attribute<BasicTransform<float>>(0).X << std::endl;
+    return 0;
+}
+
+#endif // FIXED_POINT_ENABLE_EXAMPLES
+
+#endif // FIXED_POINT_TRANSFORM_CPP
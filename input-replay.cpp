@@ -0,0 +1,283 @@
+#ifndef INPUT_REPLAY_CPP
+#define INPUT_REPLAY_CPP
+
+#include "world-state-hash.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+// --- Tier 5: Input Recording and Deterministic Replay ---
+// Everything that enters the simulation from outside (player commands, network
+// messages) is recorded per frame together with the world state hash after
+// that frame. Replaying feeds the same inputs to the same update function on a
+// freshly built pool, headless and unthrottled, and compares hashes frame by
+// frame. Because the work per frame is a real captured session, the runner's
+// timings double as a macro-benchmark of Update throughput.
+
+template <typename TInput>
+class InputRecording {
+public:
+    static_assert(std::is_trivially_copyable_v<TInput>,
+        "InputRecording Error: Inputs are stored as raw bytes and must be trivially copyable.");
+
+    InputRecording() { FrameOffsets.push_back(0); }
+
+    // Frame offsets are 32-bit, on disk and in memory.
+    static constexpr std::size_t MaxInputs = 0xFFFFFFFFu;
+
+    // --- Recording ---
+    // Returns false, dropping Input, once the recording holds MaxInputs. The
+    // recording then stops: later frames would replay against a world that
+    // never saw the dropped input.
+    bool Record(const TInput& Input) {
+        if (Stopped || Inputs.size() >= MaxInputs) {
+            Stopped = true;
+            return false;
+        }
+        Inputs.push_back(Input);
+        return true;
+    }
+
+    // Closes the current frame with the state hash observed after simulating
+    // it. Refuses a frame that lost inputs, and every frame after it: the
+    // partial frame is discarded, so the recording stays a replayable prefix
+    // of the session.
+    bool EndFrame(std::uint64_t StateHash) {
+        if (Stopped) {
+            Inputs.resize(FrameOffsets.back());
+            return false;
+        }
+        FrameOffsets.push_back(static_cast<std::uint32_t>(Inputs.size()));
+        Hashes.push_back(StateHash);
+        return true;
+    }
+
+    // Whether a dropped input stopped the recording.
+    bool Truncated() const { return Stopped; }
+
+    // --- Playback ---
+    std::size_t FrameCount() const { return Hashes.size(); }
+    std::uint64_t FrameHash(std::size_t Frame) const { return Hashes[Frame]; }
+    std::span<const TInput> FrameInputs(std::size_t Frame) const {
+        return { Inputs.data() + FrameOffsets[Frame], FrameOffsets[Frame + 1] - FrameOffsets[Frame] };
+    }
+
+    // --- Files ---
+    // Layout: header, frame offsets, frame hashes, inputs; each written as one
+    // block so loading a long session is a few large reads.
+    bool Save(const std::string& Path) const {
+        std::FILE* File = std::fopen(Path.c_str(), "wb");
+        if (!File) return false;
+        const Header Head{ Magic, FormatVersion, sizeof(TInput), FrameCount(), Inputs.size() };
+        const bool Written = std::fwrite(&Head, sizeof(Head), 1, File) == 1
+            && std::fwrite(FrameOffsets.data(), sizeof(std::uint32_t), FrameOffsets.size(), File) == FrameOffsets.size()
+            && std::fwrite(Hashes.data(), sizeof(std::uint64_t), Hashes.size(), File) == Hashes.size()
+            && std::fwrite(Inputs.data(), sizeof(TInput), Inputs.size(), File) == Inputs.size();
+        return std::fclose(File) == 0 && Written;
+    }
+
+    // Fails, leaving the recording empty, unless the file is exactly one
+    // recording: the counts in the header must match the file size, and the
+    // frame offsets must start at 0, never decrease and end at the input count.
+    bool Load(const std::string& Path) {
+        std::FILE* File = std::fopen(Path.c_str(), "rb");
+        if (!File) return false;
+        Header Head{};
+        bool Read = std::fseek(File, 0, SEEK_END) == 0;
+        const long FileSize = Read ? std::ftell(File) : -1;
+        Read = Read && FileSize >= long(sizeof(Head)) && std::fseek(File, 0, SEEK_SET) == 0
+            && std::fread(&Head, sizeof(Head), 1, File) == 1
+            && Head.Magic == Magic && Head.Version == FormatVersion && Head.InputSize == sizeof(TInput);
+        if (Read) {
+            // Bounded by the file size before anything is allocated.
+            const std::uint64_t Remaining = std::uint64_t(FileSize) - sizeof(Head);
+            constexpr std::uint64_t FrameBytes = sizeof(std::uint32_t) + sizeof(std::uint64_t);
+            Read = Head.FrameCount < Remaining / FrameBytes && Head.InputCount <= Remaining / sizeof(TInput)
+                && Head.InputCount <= MaxInputs
+                && (Head.FrameCount + 1) * sizeof(std::uint32_t) + Head.FrameCount * sizeof(std::uint64_t)
+                   + Head.InputCount * sizeof(TInput) == Remaining;
+        }
+        if (Read) {
+            FrameOffsets.resize(Head.FrameCount + 1);
+            Hashes.resize(Head.FrameCount);
+            Inputs.resize(Head.InputCount);
+            Stopped = false;
+            Read = std::fread(FrameOffsets.data(), sizeof(std::uint32_t), FrameOffsets.size(), File) == FrameOffsets.size()
+                && std::fread(Hashes.data(), sizeof(std::uint64_t), Hashes.size(), File) == Hashes.size()
+                && std::fread(Inputs.data(), sizeof(TInput), Inputs.size(), File) == Inputs.size()
+                && FrameOffsets.front() == 0 && FrameOffsets.back() == Inputs.size()
+                && std::is_sorted(FrameOffsets.begin(), FrameOffsets.end());
+        }
+        std::fclose(File);
+        if (!Read) *this = InputRecording();
+        return Read;
+    }
+
+private:
+    static constexpr std::uint32_t Magic = 0x594C5052; // "RPLY"
+    static constexpr std::uint32_t FormatVersion = 1;
+
+    struct Header {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint64_t InputSize;
+        std::uint64_t FrameCount;
+        std::uint64_t InputCount;
+    };
+
+    std::vector<TInput> Inputs;
+    std::vector<std::uint32_t> FrameOffsets;
+    std::vector<std::uint64_t> Hashes;
+    bool Stopped = false;
+};
+
+struct ReplayOptions {
+    bool VerifyHashes = true;     // Off to time the update function alone.
+    bool StopAtDivergence = true;
+    unsigned HashThreads = 1;
+};
+
+struct ReplayReport {
+    static constexpr std::size_t NoDivergence = ~std::size_t(0);
+
+    std::size_t FramesRun = 0;
+    std::size_t FirstDivergentFrame = NoDivergence;
+    double UpdateSeconds = 0.0;
+    double HashSeconds = 0.0;
+
+    bool Matches() const { return FirstDivergentFrame == NoDivergence; }
+    double FramesPerSecond() const { return UpdateSeconds > 0.0 ? FramesRun / UpdateSeconds : 0.0; }
+};
+
+// Re-executes a recording on Pool, which must be in the state the recording
+// started from. Step(Pool, Inputs) simulates one frame; the pool version is
+// advanced after every frame, as the live game loop does.
+template <typename TPool, typename TInput, typename TStep>
+ReplayReport Replay(TPool& Pool, const InputRecording<TInput>& Recording, TStep&& Step, const ReplayOptions& Options = {}) {
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+
+    ReplayReport Report;
+    WorldStateHasher<TPool> Hasher(Pool);
+    for (std::size_t Frame = 0; Frame < Recording.FrameCount(); ++Frame) {
+        const auto UpdateStart = Clock::now();
+        Step(Pool, Recording.FrameInputs(Frame));
+        const auto UpdateEnd = Clock::now();
+        Report.UpdateSeconds += Seconds(UpdateEnd - UpdateStart).count();
+        ++Report.FramesRun;
+
+        if (Options.VerifyHashes) {
+            const bool FrameMatches = Hasher.Hash(Options.HashThreads) == Recording.FrameHash(Frame);
+            Report.HashSeconds += Seconds(Clock::now() - UpdateEnd).count();
+            if (!FrameMatches && Report.Matches()) {
+                Report.FirstDivergentFrame = Frame;
+                if (Options.StopAtDivergence) break;
+            }
+        }
+        Pool.AdvanceVersion();
+    }
+    return Report;
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef REPLAY_ENABLE_EXAMPLES
+
+#include <filesystem>
+#include <random>
+
+struct Transform : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+
+struct MoveCommand {
+    std::uint32_t Target;
+    float DeltaX;
+};
+
+// The only way external input reaches the simulation.
+class CommandMover : public Role {
+public:
+    using RequiredAttributes = TypeList<Transform>;
+    template <typename TPool>
+    void Update(TPool& Pool, std::span<const MoveCommand> Commands) const {
+        for (const MoveCommand& Command : Commands) Pool.template Attribute<Transform>(Command.Target).X += Command.DeltaX;
+    }
+};
+
+class Unit : public Composition<Unit, TypeList<CommandMover>, TypeList<Transform>> {};
+
+using UnitPool = CompositionPool<Unit>;
+
+void BuildLevel(UnitPool& Pool) {
+    for (std::uint32_t Index = 0; Index < 50000; ++Index) Pool.Spawn(Transform{{}, float(Index % 100), 0.0f, 0.0f});
+}
+
+int main() {
+    const auto Step = [](UnitPool& Pool, std::span<const MoveCommand> Commands) { CommandMover{}.Update(Pool, Commands); };
+    const std::string Path = (std::filesystem::temp_directory_path() / "composition-session.replay").string();
+
+    // Live session: inputs come from a "player", hashes from the running world.
+    {
+        UnitPool Pool;
+        BuildLevel(Pool);
+        WorldStateHasher<UnitPool> Hasher(Pool);
+        InputRecording<MoveCommand> Recording;
+        std::mt19937 Player(42);
+        bool Recorded = true;
+        for (int Frame = 0; Frame < 600 && Recorded; ++Frame) {
+            std::vector<MoveCommand> Commands;
+            for (int Command = 0; Command < 200; ++Command) {
+                Commands.push_back({ static_cast<std::uint32_t>(Player() % Pool.Size()), float(Player() % 9) - 4.0f });
+            }
+            for (const MoveCommand& Command : Commands) Recorded = Recording.Record(Command) && Recorded;
+            Step(Pool, Commands);
+            Recorded = Recording.EndFrame(Hasher.Hash()) && Recorded;
+            Pool.AdvanceVersion();
+        }
+        if (!Recorded) std::cout << "Recording stopped after " << Recording.FrameCount() << " frames: too many inputs\n";
+        if (!Recording.Save(Path)) {
+            std::cout << "Could not save " << Path << std::endl;
+            return 1;
+        }
+    }
+
+    // Offline: replay the captured file headless.
+    InputRecording<MoveCommand> Loaded;
+    if (!Loaded.Load(Path)) {
+        std::cout << "Could not load " << Path << std::endl;
+        return 1;
+    }
+    UnitPool Verified;
+    BuildLevel(Verified);
+    const ReplayReport Check = Replay(Verified, Loaded, Step);
+
+    UnitPool Timed;
+    BuildLevel(Timed);
+    const ReplayReport Bench = Replay(Timed, Loaded, Step, ReplayOptions{ .VerifyHashes = false });
+
+    std::cout << "Replayed " << Check.FramesRun << " frames: " << (Check.Matches() ? "deterministic" : "DESYNC") << "\n"
+              << "Update throughput: " << Bench.FramesPerSecond() << " frames/s"
+              << " (hash verification adds " << Check.HashSeconds * 1000.0 / Check.FramesRun << " ms/frame)\n";
+
+    // A damaged file is rejected instead of replayed: here a frame offset
+    // that points past the inputs.
+    if (std::FILE* File = std::fopen(Path.c_str(), "r+b")) {
+        const std::uint32_t Damaged = 0xFFFFFF00u;
+        std::fseek(File, 32 + sizeof(std::uint32_t), SEEK_SET);
+        std::fwrite(&Damaged, sizeof(Damaged), 1, File);
+        std::fclose(File);
+    }
+    std::cout << "Damaged recording rejected: " << (!Loaded.Load(Path) && Loaded.FrameCount() == 0 ? "yes" : "no") << std::endl;
+    std::filesystem::remove(Path);
+    return 0;
+}
+
+#endif // REPLAY_ENABLE_EXAMPLES
+
+#endif // INPUT_REPLAY_CPP
@@ -0,0 +1,458 @@
+#ifndef PERSISTENT_WORLD_STORE_CPP
+#define PERSISTENT_WORLD_STORE_CPP
+
+#include "attribute-serialization.cpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// --- Tier 6: Incremental Persistent World Store ---
+// Long-running worlds are persisted to an append-only log. Checkpoint() writes
+// one record per chunk stamped since the previous checkpoint, then a commit
+// record, then syncs the file, so autosave cost follows the change rate
+// rather than the world size.
+//
+// Every record carries a checksum. Recovery replays the log up to the last
+// intact commit, so a crash (including a torn write) loses at most the
+// checkpoint in flight. Whatever follows the last commit is truncated away on
+// Open().
+//
+// Chunk records hold every field of every Attribute as a compressed column
+// (see columnar-codec.cpp). They carry no per-record schema, so the log header
+// stores SchemaHashOf<TPool>() and Open() refuses a mismatch (use
+// SavePool/LoadPool with migrations to carry data across schema changes).
+// Once the log outgrows the live data by CompactionFactor, it is rewritten
+// with only the latest state and swapped in with an atomic rename. The
+// directory is synced after the rename so the swap itself survives a crash.
+
+template <typename TPool>
+class PersistentWorldStore {
+public:
+    explicit PersistentWorldStore(std::string InPath, double InCompactionFactor = 4.0)
+        : Path(std::move(InPath)), CompactionFactor(InCompactionFactor) {}
+
+    ~PersistentWorldStore() {
+        if (File) std::fclose(File);
+    }
+
+    PersistentWorldStore(const PersistentWorldStore&) = delete;
+    PersistentWorldStore& operator=(const PersistentWorldStore&) = delete;
+
+    // Recovers the last committed checkpoint into an empty pool (or starts a
+    // new log) and prepares the store for appending. Advances the pool version
+    // so that only later changes count towards the next checkpoint.
+    bool Open(TPool& Pool) {
+        if (File || Pool.Size() != 0) return false;
+        std::error_code Error;
+        if (!std::filesystem::exists(Path, Error) || std::filesystem::file_size(Path, Error) == 0) {
+            return StartLog();
+        }
+
+        std::vector<std::byte> Image;
+        if (!SerializationDetail::ReadFile(Path, Image)) return false;
+        std::uint64_t ValidEnd = 0;
+        if (!Recover(Pool, Image, ValidEnd)) return false;
+
+        std::filesystem::resize_file(Path, ValidEnd, Error);
+        if (Error) return false;
+        File = std::fopen(Path.c_str(), "r+b");
+        if (!File || std::fseek(File, 0, SEEK_END) != 0) return false;
+        LogSize = ValidEnd;
+        Pool.AdvanceVersion();
+        BaselineVersion = Pool.Version();
+        return true;
+    }
+
+    // Appends every chunk stamped since the last checkpoint plus a commit, and
+    // syncs. A failed write is cut off again, so the log still ends at the last
+    // commit. Compacts afterwards if the log has grown too large; the
+    // checkpoint is committed either way, and a failed compaction is only
+    // counted in CompactionFailures().
+    bool Checkpoint(const TPool& Pool) {
+        if (!File) return false;
+        Buffer.clear();
+        ++CheckpointCount;
+        std::vector<std::uint64_t> RecordBytes = LiveRecordBytes;
+        RecordBytes.resize(Pool.ChunkCount(), 0);
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Pool.ChunkCount(); ++ChunkIndex) {
+            if (Pool.ChunkVersion(ChunkIndex) >= BaselineVersion) {
+                RecordBytes[ChunkIndex] = AppendChunkRecord(Pool, ChunkIndex);
+            }
+        }
+        AppendCommitRecord(Pool);
+        if (!WriteAndSync(File)) {
+            DiscardUncommitted();
+            return false;
+        }
+        LogSize += Buffer.size();
+        LiveRecordBytes = std::move(RecordBytes);
+        BaselineVersion = Pool.Version();
+
+        if (LogSize > MinimumCompactionBytes && LogSize > CompactionFactor * LiveBytes() && !Compact(Pool)) {
+            ++CompactionFailureCount;
+        }
+        return true;
+    }
+
+    // Rewrites the log with just the pool's current state. On failure the
+    // store keeps appending to the old log, and its sizes still describe it.
+    bool Compact(const TPool& Pool) {
+        if (!File) return false;
+        const std::string Staging = Path + ".compact";
+        std::FILE* Compacted = std::fopen(Staging.c_str(), "wb");
+        if (!Compacted) return false;
+
+        Buffer.clear();
+        AppendFileHeader();
+        ++CheckpointCount;
+        std::vector<std::uint64_t> CompactedRecordBytes(Pool.ChunkCount(), 0);
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Pool.ChunkCount(); ++ChunkIndex) {
+            CompactedRecordBytes[ChunkIndex] = AppendChunkRecord(Pool, ChunkIndex);
+        }
+        AppendCommitRecord(Pool);
+        const bool Written = WriteAndSync(Compacted);
+        std::error_code Error;
+        if (std::fclose(Compacted) != 0 || !Written) {
+            std::filesystem::remove(Staging, Error);
+            return false;
+        }
+
+        std::fclose(File);
+        File = nullptr;
+        std::filesystem::rename(Staging, Path, Error);
+        const bool Swapped = !Error;
+        if (Swapped) {
+            LogSize = Buffer.size();
+            LiveRecordBytes = std::move(CompactedRecordBytes);
+        } else {
+            std::filesystem::remove(Staging, Error);
+        }
+        File = std::fopen(Path.c_str(), "r+b");
+        if (!File || std::fseek(File, 0, SEEK_END) != 0) return false;
+        if (!Swapped || !SyncDirectory()) return false;
+        BaselineVersion = Pool.Version();
+        ++CompactionCount;
+        return true;
+    }
+
+    std::uint64_t LogBytes() const { return LogSize; }
+    std::uint64_t LiveBytes() const {
+        std::uint64_t Live = sizeof(FileHeader) + sizeof(RecordHeader) + sizeof(CommitPayload);
+        for (const std::uint64_t Bytes : LiveRecordBytes) Live += Bytes;
+        return Live;
+    }
+    std::uint64_t Compactions() const { return CompactionCount; }
+    std::uint64_t CompactionFailures() const { return CompactionFailureCount; }
+
+private:
+    static constexpr std::uint32_t Magic = 0x474F4C43; // "CLOG"
+    static constexpr std::uint32_t RecordMagic = 0x44524352; // "RCRD"
+    static constexpr std::uint32_t FormatVersion = 2;
+    static constexpr std::uint64_t MinimumCompactionBytes = std::uint64_t(1) << 20;
+
+    enum RecordKind : std::uint32_t { ChunkRecord = 1, CommitRecord = 2 };
+
+    struct FileHeader {
+        std::uint32_t Magic;
+        std::uint32_t Version;
+        std::uint64_t SchemaHash;
+    };
+    struct RecordHeader {
+        std::uint32_t Magic;
+        std::uint32_t Kind;
+        std::uint64_t Checkpoint;
+        std::uint64_t PayloadSize;
+        std::uint64_t Checksum;
+    };
+    struct CommitPayload {
+        std::uint64_t InstanceCount;
+        std::uint64_t ChunkCount;
+    };
+    struct ChunkLocation {
+        std::size_t Offset = 0;
+        std::size_t Size = 0;
+        bool Present = false;
+    };
+
+    static std::uint64_t Checksum(const RecordHeader& Header, const std::byte* Payload) {
+        StateHasher Hasher(Header.Checkpoint);
+        Hasher.AppendValue(Header.Kind);
+        Hasher.AppendValue(Header.PayloadSize);
+        Hasher.Append(Payload, Header.PayloadSize);
+        return Hasher.Finish();
+    }
+
+    bool StartLog() {
+        File = std::fopen(Path.c_str(), "wb");
+        if (!File) return false;
+        Buffer.clear();
+        AppendFileHeader();
+        if (!WriteAndSync(File)) return false;
+        LogSize = Buffer.size();
+        BaselineVersion = 0; // Everything in the pool is new to the log.
+        return true;
+    }
+
+    void AppendFileHeader() {
+        const FileHeader Header{ Magic, FormatVersion, SchemaHashOf<TPool>() };
+        SerializationDetail::AppendBytes(Buffer, &Header, sizeof(Header));
+    }
+
+    // Fills in the header reserved at HeaderStart for the payload that follows it.
+    std::size_t SealRecord(std::size_t HeaderStart, RecordKind Kind) {
+        RecordHeader Header{ RecordMagic, Kind, CheckpointCount, Buffer.size() - HeaderStart - sizeof(RecordHeader), 0 };
+        Header.Checksum = Checksum(Header, Buffer.data() + HeaderStart + sizeof(RecordHeader));
+        std::memcpy(Buffer.data() + HeaderStart, &Header, sizeof(Header));
+        return Buffer.size() - HeaderStart;
+    }
+
+    std::size_t AppendChunkRecord(const TPool& Pool, std::size_t ChunkIndex) {
+        const std::size_t HeaderStart = Buffer.size();
+        Buffer.resize(HeaderStart + sizeof(RecordHeader));
+        const std::uint32_t Index = static_cast<std::uint32_t>(ChunkIndex), Count = Pool.ChunkSize(ChunkIndex);
+        SerializationDetail::AppendBytes(Buffer, &Index, sizeof(Index));
+        SerializationDetail::AppendBytes(Buffer, &Count, sizeof(Count));
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ([&] {
+                using T = typename TPool::template AttributeAt<I>;
+                const T* Column = Pool.template Column<T>(ChunkIndex);
+                [&]<std::size_t... F>(std::index_sequence<F...>) {
+                    (WriteField<T, F>(Column, Count), ...);
+                }(std::make_index_sequence<FieldCount<T>>{});
+            }(), ...);
+        }(std::make_index_sequence<TPool::AttributeCount>{});
+        return SealRecord(HeaderStart, ChunkRecord);
+    }
+
+    void AppendCommitRecord(const TPool& Pool) {
+        const std::size_t HeaderStart = Buffer.size();
+        Buffer.resize(HeaderStart + sizeof(RecordHeader));
+        const CommitPayload Commit{ Pool.Size(), Pool.ChunkCount() };
+        SerializationDetail::AppendBytes(Buffer, &Commit, sizeof(Commit));
+        SealRecord(HeaderStart, CommitRecord);
+    }
+
+    bool WriteAndSync(std::FILE* Target) {
+        if (std::fwrite(Buffer.data(), 1, Buffer.size(), Target) != Buffer.size() || std::fflush(Target) != 0) return false;
+#if defined(__unix__) || defined(__APPLE__)
+        return ::fsync(::fileno(Target)) == 0;
+#else
+        return true;
+#endif
+    }
+
+    // Cuts the log back to LogSize after a failed append. The file is closed
+    // first so that no buffered bytes reach it after the cut. If it cannot be
+    // reopened the store stops appending rather than write behind a torn
+    // record, which Recover() would never read past.
+    void DiscardUncommitted() {
+        std::fclose(File);
+        File = nullptr;
+        std::error_code Error;
+        std::filesystem::resize_file(Path, LogSize, Error);
+        if (Error) return;
+        File = std::fopen(Path.c_str(), "r+b");
+        if (File && std::fseek(File, 0, SEEK_END) != 0) {
+            std::fclose(File);
+            File = nullptr;
+        }
+    }
+
+    // Makes a rename in the log's directory durable.
+    bool SyncDirectory() const {
+#if defined(__unix__) || defined(__APPLE__)
+        std::filesystem::path Directory = std::filesystem::path(Path).parent_path();
+        if (Directory.empty()) Directory = ".";
+        const int Handle = ::open(Directory.c_str(), O_RDONLY | O_DIRECTORY);
+        if (Handle < 0) return false;
+        const bool Synced = ::fsync(Handle) == 0;
+        ::close(Handle);
+        return Synced;
+#else
+        return true;
+#endif
+    }
+
+    // Scans the log, keeping the newest committed record of every chunk, then
+    // rebuilds the pool from them. ValidEnd is the end of the last commit.
+    // Chunks are decoded into a staging pool without hooks and only moved
+    // into Pool once all of them decoded, so a damaged log leaves Pool empty
+    // and OnCreate/OnEnable see the recovered values.
+    bool Recover(TPool& Pool, const std::vector<std::byte>& Image, std::uint64_t& ValidEnd) {
+        SerializationDetail::ByteReader Reader(Image);
+        FileHeader Header{};
+        if (!Reader.Read(Header) || Header.Magic != Magic || Header.Version != FormatVersion) return false;
+        if (Header.SchemaHash != SchemaHashOf<TPool>()) return false;
+        ValidEnd = Reader.Position();
+
+        std::vector<ChunkLocation> Committed, Pending;
+        CommitPayload LastCommit{ 0, 0 };
+        RecordHeader Record{};
+        while (Reader.Read(Record) && Record.Magic == RecordMagic && Record.PayloadSize <= Reader.Remaining()) {
+            const std::size_t PayloadOffset = Reader.Position();
+            if (Checksum(Record, Image.data() + PayloadOffset) != Record.Checksum) break;
+            Reader.Skip(Record.PayloadSize);
+            CheckpointCount = std::max(CheckpointCount, Record.Checkpoint);
+
+            if (Record.Kind == ChunkRecord && Record.PayloadSize >= 2 * sizeof(std::uint32_t)) {
+                std::uint32_t ChunkIndex = 0;
+                std::memcpy(&ChunkIndex, Image.data() + PayloadOffset, sizeof(ChunkIndex));
+                if (Pending.size() <= ChunkIndex) Pending.resize(ChunkIndex + 1);
+                Pending[ChunkIndex] = { PayloadOffset, static_cast<std::size_t>(Record.PayloadSize), true };
+            } else if (Record.Kind == CommitRecord && Record.PayloadSize == sizeof(CommitPayload)) {
+                std::memcpy(&LastCommit, Image.data() + PayloadOffset, sizeof(LastCommit));
+                if (Committed.size() < Pending.size()) Committed.resize(Pending.size());
+                for (std::size_t ChunkIndex = 0; ChunkIndex < Pending.size(); ++ChunkIndex) {
+                    if (Pending[ChunkIndex].Present) Committed[ChunkIndex] = Pending[ChunkIndex];
+                }
+                Pending.clear();
+                ValidEnd = Reader.Position();
+            } else {
+                break;
+            }
+        }
+
+        if (Committed.size() < LastCommit.ChunkCount) return false;
+        TPool Staging;
+        LiveRecordBytes.assign(LastCommit.ChunkCount, 0);
+        for (std::size_t ChunkIndex = 0; ChunkIndex < LastCommit.ChunkCount; ++ChunkIndex) {
+            const ChunkLocation& Location = Committed[ChunkIndex];
+            if (!Location.Present) return false;
+            SerializationDetail::ByteReader Payload(std::span<const std::byte>(Image.data() + Location.Offset, Location.Size));
+            if (!DecodeChunk(Staging, ChunkIndex, Payload)) return false;
+            LiveRecordBytes[ChunkIndex] = sizeof(RecordHeader) + Location.Size;
+        }
+        if (Staging.Size() != LastCommit.InstanceCount) return false;
+
+        for (auto& Next : Staging.ReleaseChunks()) Pool.AppendChunk(std::move(Next));
+        Pool.RunSpawnHooks(0, Pool.Size());
+        return true;
+    }
+
+    static bool DecodeChunk(TPool& Pool, std::size_t ChunkIndex, SerializationDetail::ByteReader& Payload) {
+        std::uint32_t Index = 0, Count = 0;
+        if (!Payload.Read(Index) || !Payload.Read(Count) || Count > TPool::Capacity) return false;
+        if (Count == 0) return true;
+        if (Pool.AllocateDefault(Count) != ChunkIndex * TPool::Capacity) return false; // Chunks must be densely packed.
+        bool Decoded = true;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ([&] {
+                using T = typename TPool::template AttributeAt<I>;
+                T* Column = Pool.template MutableColumn<T>(ChunkIndex);
+                [&]<std::size_t... F>(std::index_sequence<F...>) {
+                    ((Decoded = Decoded && ReadField<T, F>(Payload, Column, Count)), ...);
+                }(std::make_index_sequence<FieldCount<T>>{});
+            }(), ...);
+        }(std::make_index_sequence<TPool::AttributeCount>{});
+        return Decoded;
+    }
+
+    template <typename T, std::size_t Field>
+    void WriteField(const T* Column, std::size_t Count) {
+        using F = FieldType<T, Field>;
+        std::vector<F> Values(Count);
+        for (std::size_t Slot = 0; Slot < Count; ++Slot) Values[Slot] = std::get<Field>(TieFields(Column[Slot]));
+        SerializationDetail::WriteFieldColumn(std::span<const F>(Values), Buffer);
+    }
+
+    template <typename T, std::size_t Field>
+    static bool ReadField(SerializationDetail::ByteReader& Payload, T* Column, std::size_t Count) {
+        using F = FieldType<T, Field>;
+        std::vector<F> Values(Count);
+        if (!SerializationDetail::ReadFieldColumn(Payload, std::span<F>(Values))) return false;
+        for (std::size_t Slot = 0; Slot < Count; ++Slot) std::get<Field>(TieFields(Column[Slot])) = std::move(Values[Slot]);
+        return true;
+    }
+
+    std::string Path;
+    double CompactionFactor;
+    std::FILE* File = nullptr;
+    std::vector<std::byte> Buffer;
+    std::vector<std::uint64_t> LiveRecordBytes; // Size of each chunk's newest record.
+    std::uint64_t LogSize = 0;
+    std::uint64_t BaselineVersion = 0;
+    std::uint64_t CheckpointCount = 0;
+    std::uint64_t CompactionCount = 0;
+    std::uint64_t CompactionFailureCount = 0;
+};
+
+
+// --- EXAMPLE USAGE ---
+#ifdef WORLD_STORE_ENABLE_EXAMPLES
+
+#include <fstream>
+
+struct Transform : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Category : public Attribute {
+    std::string Name = "Default";
+};
+inline void HashValue(StateHasher& Hasher, const Category& Value) { HashValue(Hasher, Value.Name); }
+
+// Counts the buildings whose OnCreate saw a real name.
+std::size_t NamedOnCreate = 0;
+
+class Registrar : public Role {
+public:
+    template <typename THost>
+    void OnCreate(THost& Host) { NamedOnCreate += Host.template Attribute<Category>().Name != "Default"; }
+};
+
+class Building : public Composition<Building, TypeList<Registrar>, TypeList<Transform, Category>> {};
+
+using BuildingPool = CompositionPool<Building>;
+
+int main() {
+    const std::string Path = (std::filesystem::temp_directory_path() / "composition-world.log").string();
+    std::filesystem::remove(Path);
+
+    std::uint64_t CommittedHash = 0;
+    {
+        BuildingPool World;
+        PersistentWorldStore<BuildingPool> Store(Path);
+        Store.Open(World);
+        for (int Index = 0; Index < 100000; ++Index) World.Spawn(Transform{{}, float(Index), 0.0f, 0.0f}, Category{{}, "House"});
+        Store.Checkpoint(World);
+        const std::uint64_t FullSize = Store.LogBytes();
+
+        // Two hours of play where a few districts change between autosaves.
+        for (int Autosave = 0; Autosave < 120; ++Autosave) {
+            for (int Frame = 0; Frame < 10; ++Frame) {
+                const std::size_t District = (Autosave * 7 + Frame) % World.ChunkCount();
+                World.MutableColumn<Transform>(District)[Frame].Z += 1.0f;
+                World.AdvanceVersion();
+            }
+            Store.Checkpoint(World);
+        }
+        CommittedHash = WorldStateHasher<BuildingPool>(World).Hash();
+        std::cout << "Initial save " << FullSize << " bytes; after 120 autosaves the log is " << Store.LogBytes()
+                  << " bytes (" << Store.Compactions() << " compactions)\n";
+
+        // Changes after the last autosave, then a crash halfway through writing.
+        World.Attribute<Transform>(0).X = -1.0f;
+        std::ofstream(Path, std::ios::app | std::ios::binary) << "RCRDtorn";
+    }
+
+    NamedOnCreate = 0;
+    BuildingPool Recovered;
+    PersistentWorldStore<BuildingPool> Store(Path);
+    const bool Opened = Store.Open(Recovered);
+    std::cout << "Recovered " << Recovered.Size() << " buildings: " << (Opened ? "ok" : "failed") << ", state "
+              << (WorldStateHasher<BuildingPool>(Recovered).Hash() == CommittedHash ? "matches last checkpoint" : "DIFFERS")
+              << ", OnCreate saw recovered names for " << NamedOnCreate << std::endl;
+    std::filesystem::remove(Path);
+    return 0;
+}
+
+#endif // WORLD_STORE_ENABLE_EXAMPLES
+
+#endif // PERSISTENT_WORLD_STORE_CPP
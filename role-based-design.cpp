@@ -1,83 +1,289 @@
+#ifndef ROLE_BASED_DESIGN_CPP
+#define ROLE_BASED_DESIGN_CPP
+
+#include "type-list.cpp"
 
 #include <tuple>
 #include <type_traits>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <utility> // For std::forward
 
 // --- Tier 0: Core Metaprogramming Utilities ---
-template <typename... T>
-struct TypeList {};
+// TypeList and its algorithms live in type-list.cpp.
 
 template <typename... Types>
 class SimpleTuple; // Assume our robust SimpleTuple exists
 
+// The fully qualified name of T, read out of the compiler's function signature.
+// Spelling differs between compilers, so it is only stable within one toolchain.
+template <typename T>
+constexpr std::string_view TypeName() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    std::string_view Name = __FUNCSIG__;
+    Name.remove_prefix(Name.find("TypeName<") + 9);
+    Name.remove_suffix(Name.size() - Name.rfind(">(void)"));
+    for (std::string_view Keyword : { std::string_view("struct "), std::string_view("class "), std::string_view("enum ") }) {
+        if (Name.substr(0, Keyword.size()) == Keyword) Name.remove_prefix(Keyword.size());
+    }
+#else
+    std::string_view Name = __PRETTY_FUNCTION__;
+    Name.remove_prefix(Name.find("T = ") + 4);
+    Name = Name.substr(0, Name.find_first_of(";]"));
+#endif
+    return Name;
+}
+
 // --- Tier 1: Marker Structs (Hardened) ---
 struct Attribute {};
 
-// The Role marker now provides a default for RequiredAttributes.
+// The Role marker provides defaults for both kinds of dependency. A Role may
+// require Attributes, and other Roles (e.g. a Shooter requires a Mover).
 struct Role {
     using RequiredAttributes = TypeList<>;
+    using RequiredRoles = TypeList<>;
 };
 
+namespace RoleDetail {
+    // Grows the list by every listed Role's RequiredRoles until nothing new
+    // is added. Each step is one flat Concat, so the depth is the length of
+    // the longest dependency chain, and cycles end the walk.
+    template <typename TRole>
+    using WithRequired = Concat<TypeList<TRole>, typename TRole::RequiredRoles>;
+
+    template <typename TRolesList>
+    struct Done {
+        using Type = TRolesList;
+    };
+
+    template <typename TRolesList>
+    struct Closure;
+    template <typename... TRoles>
+    struct Closure<TypeList<TRoles...>> {
+        using Grown = Unique<Concat<WithRequired<TRoles>...>>;
+        using Type = typename std::conditional_t<ListSize<Grown> == sizeof...(TRoles),
+            Done<Grown>, Closure<Grown>>::Type;
+    };
+} // namespace RoleDetail
+
+// The Roles of TRolesList plus every Role they require, directly or not.
+template <typename TRolesList>
+using RoleClosure = typename RoleDetail::Closure<TRolesList>::Type;
+
+// TRole requires TOther, directly or through one of its required Roles.
+template <typename TRole, typename TOther>
+inline constexpr bool RequiresRole = Contains<RoleClosure<typename TRole::RequiredRoles>, TOther>;
+
+// --- Lifecycle Hooks ---
+// A Role may define any of OnCreate(Host&), OnDestroy(Host&) and
+// OnEnable(Host&), usually as templates over the host type. They are found
+// by concept, so a Role without them compiles to no call at all. Hooks run in
+// RolesList order, OnDestroy in reverse.
+enum class LifecycleEvent { Create, Destroy, Enable };
+
+template <typename TRole, typename THost>
+concept HasOnCreate = requires(TRole& InRole, THost& InHost) { InRole.OnCreate(InHost); };
+template <typename TRole, typename THost>
+concept HasOnDestroy = requires(TRole& InRole, THost& InHost) { InRole.OnDestroy(InHost); };
+template <typename TRole, typename THost>
+concept HasOnEnable = requires(TRole& InRole, THost& InHost) { InRole.OnEnable(InHost); };
+
+template <typename TRole, typename THost, LifecycleEvent Event>
+concept HasLifecycleHook = (Event == LifecycleEvent::Create && HasOnCreate<TRole, THost>)
+    || (Event == LifecycleEvent::Destroy && HasOnDestroy<TRole, THost>)
+    || (Event == LifecycleEvent::Enable && HasOnEnable<TRole, THost>);
+
+template <typename TRole, typename THost>
+concept HasAnyLifecycleHook = HasOnCreate<TRole, THost> || HasOnDestroy<TRole, THost> || HasOnEnable<TRole, THost>;
+
+template <LifecycleEvent Event, typename TRole, typename THost>
+constexpr void InvokeLifecycleHook(TRole& InRole, THost& InHost) {
+    if constexpr (Event == LifecycleEvent::Create && HasOnCreate<TRole, THost>) InRole.OnCreate(InHost);
+    else if constexpr (Event == LifecycleEvent::Destroy && HasOnDestroy<TRole, THost>) InRole.OnDestroy(InHost);
+    else if constexpr (Event == LifecycleEvent::Enable && HasOnEnable<TRole, THost>) InRole.OnEnable(InHost);
+}
+
 
 // --- Tier 2: The 'Composition' CRTP Base Class (Version 2.0) ---
+// Roles and Attributes are constructed in place from tagged argument packs:
+//
+//     Composition(std::piecewise_construct, InPlace<Logger>(InName), InPlace<Transform>(100.0f, 0.0f, 0.0f))
+//
+// InPlace<T>(Args...) only captures references, and every member is built
+// directly from its own arguments, so nothing is constructed twice or moved.
+// Tags may come in any order, and members without one are value-initialized.
+// Aggregates derived from Attribute or Role take their fields without the
+// empty base, as Transform does above.
+
+template <typename T, typename... TArgs>
+struct MemberArguments {
+    using Type = T;
+    std::tuple<TArgs&&...> Arguments;
+};
+
+template <typename T, typename... TArgs>
+constexpr MemberArguments<T, TArgs...> InPlace(TArgs&&... Arguments) {
+    return { std::forward_as_tuple(std::forward<TArgs>(Arguments)...) };
+}
+
+namespace CompositionDetail {
+    struct RoleTag;
+    struct AttributeTag;
+
+    // One Role or Attribute. Value is initialized directly from the caller's
+    // arguments; it is never returned from a helper, because a prvalue cannot
+    // be elided into a [[no_unique_address]] member or a base class, and that
+    // would require T to be movable. Empty Roles take no space.
+    template <typename TTag, typename T>
+    struct Member {
+        [[no_unique_address]] T Value;
+
+        constexpr Member() : Value() {}
+
+        // Takes this member's pack out of all the InPlace<>() packs, or an
+        // empty one if there is none.
+        template <typename TMarker, typename... TInits>
+        constexpr Member(TMarker* Marker, std::tuple<TInits&...>& Inits) : Member(Marker, ArgumentsFor(Inits)) {}
+
+    private:
+        template <typename... TInits>
+        static constexpr auto ArgumentsFor(std::tuple<TInits&...>& Inits) {
+            constexpr std::size_t Found = IndexOf<TypeList<typename TInits::Type...>, T>;
+            if constexpr (Found == sizeof...(TInits)) return MemberArguments<T>{};
+            else return std::move(std::get<Found>(Inits)); // Moves the references only.
+        }
+
+        template <typename TMarker, typename... TArgs>
+        constexpr Member(TMarker*, MemberArguments<T, TArgs...> Found)
+            : Member(std::bool_constant<(sizeof...(TArgs) > 0 && std::is_aggregate_v<T> && std::is_base_of_v<TMarker, T>)>{},
+                     static_cast<TMarker*>(nullptr), Found, std::index_sequence_for<TArgs...>{}) {}
+
+        template <typename TMarker, typename... TArgs, std::size_t... I>
+        constexpr Member(std::false_type, TMarker*, MemberArguments<T, TArgs...>& Found, std::index_sequence<I...>)
+            : Value(std::get<I>(std::move(Found.Arguments))...) {}
+
+        // Aggregates take their empty marker base first: Transform(Attribute{}, X, Y, Z).
+        template <typename TMarker, typename... TArgs, std::size_t... I>
+        constexpr Member(std::true_type, TMarker*, MemberArguments<T, TArgs...>& Found, std::index_sequence<I...>)
+            : Value(TMarker{}, std::get<I>(std::move(Found.Arguments))...) {}
+    };
+
+    template <typename TTag, typename TMarker, typename... T>
+    struct Storage : Member<TTag, T>... {
+        constexpr Storage() = default;
+
+        template <typename... TInits>
+        constexpr explicit Storage([[maybe_unused]] std::tuple<TInits&...> Inits)
+            : Member<TTag, T>(static_cast<TMarker*>(nullptr), Inits)... {}
+    };
+} // namespace CompositionDetail
+
 template <typename Derived, typename RolesList, typename AttributesList>
 class Composition;
 
 template <typename Derived, typename... TRoles, typename... TAttributes>
 class Composition<Derived, TypeList<TRoles...>, TypeList<TAttributes...>> {
+public:
+    using RolesList      = TypeList<TRoles...>;
+    using AttributesList = TypeList<TAttributes...>;
+
 private:
-    std::tuple<TRoles...>    RolesTuple; // Using std::tuple for robustness
-    std::tuple<TAttributes...> AttributesTuple;
+    CompositionDetail::Storage<CompositionDetail::RoleTag, ::Role, TRoles...> Roles;
+    CompositionDetail::Storage<CompositionDetail::AttributeTag, ::Attribute, TAttributes...> Attributes;
 
     // --- Compile-Time Dependency and Rule Enforcement ---
-    template<typename T, typename... TPack>
-    static constexpr bool IsTypeInPack = (std::is_same_v<T, TPack> || ...);
+    static constexpr bool DependenciesMet = (ContainsAll<AttributesList, typename TRoles::RequiredAttributes> && ...);
+    static_assert(DependenciesMet, "Composition Error: An object is missing a required attribute for one of its roles.");
 
-    template<typename T> struct CheckRoleDependencies;
-    template<typename... TRequired>
-    struct CheckRoleDependencies<TypeList<TRequired...>>
-    {
-        static constexpr bool AllPresent = (IsTypeInPack<TRequired, TAttributes...> && ...);
-    };
+    // Every Role required along a chain must be listed too, so the Attribute
+    // check above also covers the requirements of Roles pulled in that way.
+    using MissingRoles = Difference<RoleClosure<RolesList>, RolesList>;
+    static_assert(ListSize<MissingRoles> == 0,
+        "Composition Error: A Role requires another Role, directly or through its own requirements, that is not in this Composition.");
 
-    static constexpr bool DependenciesMet = (CheckRoleDependencies<typename TRoles::RequiredAttributes>::AllPresent && ...);
-    static_assert(DependenciesMet, "Composition Error: An object is missing a required attribute for one of its roles.");
+    static_assert(ListSize<Unique<RolesList>> == sizeof...(TRoles),
+        "Composition Error: A Role is listed more than once.");
+    static_assert(ListSize<Unique<AttributesList>> == sizeof...(TAttributes),
+        "Composition Error: An Attribute is listed more than once.");
 
     static_assert((std::is_aggregate_v<TAttributes> && ...),
         "Composition Error: An Attribute type is not an aggregate. Attributes must be simple data structs.");
 
+    constexpr Derived& Host() { return static_cast<Derived&>(*this); }
+
+    template <std::size_t... I>
+    constexpr void RunOnDestroyReversed(std::index_sequence<I...>) {
+        (InvokeLifecycleHook<LifecycleEvent::Destroy>(Role<TypeAt<RolesList, sizeof...(I) - 1 - I>>(), Host()), ...);
+    }
+
 public:
-    // --- FIXED: The constructor now accepts component arguments directly. ---
-    template<typename... RoleArgs, typename... AttributeArgs>
-    constexpr Composition(RoleArgs&&... roleArgs, AttributeArgs&&... attributeArgs)
-        : RolesTuple(std::forward<RoleArgs>(roleArgs)...),
-          AttributesTuple(std::forward<AttributeArgs>(attributeArgs)...)
+    constexpr Composition() = default;
+
+    template <typename... TInits>
+    constexpr explicit Composition(std::piecewise_construct_t, TInits&&... Inits)
+        : Roles(std::forward_as_tuple(Inits...)),
+          Attributes(std::forward_as_tuple(Inits...))
     {
-        static_assert(sizeof...(TRoles) == sizeof...(RoleArgs),
-            "Composition Error: Incorrect number of Roles provided to the constructor.");
-        static_assert(sizeof...(TAttributes) == sizeof...(AttributeArgs),
-            "Composition Error: Incorrect number of Attributes provided to the constructor.");
+        using Named = TypeList<typename std::remove_cvref_t<TInits>::Type...>;
+        static_assert(ContainsAll<Concat<RolesList, AttributesList>, Named>,
+            "Composition Error: InPlace<T>() names a type that is not a Role or Attribute of this Composition.");
+        static_assert(ListSize<Unique<Named>> == sizeof...(TInits),
+            "Composition Error: A Role or Attribute is given more than one InPlace<T>().");
     }
 
+    // --- Lifecycle ---
+    // A base class runs before the derived object is built and after it is
+    // torn down, so it cannot call hooks itself: the derived constructor and
+    // destructor call these, or the owner does.
+    static constexpr bool HasLifecycleHooks() { return (HasAnyLifecycleHook<TRoles, Derived> || ...); }
+
+    constexpr void RunOnCreate() { (InvokeLifecycleHook<LifecycleEvent::Create>(Role<TRoles>(), Host()), ...); }
+    constexpr void RunOnEnable() { (InvokeLifecycleHook<LifecycleEvent::Enable>(Role<TRoles>(), Host()), ...); }
+    constexpr void RunOnDestroy() { RunOnDestroyReversed(std::index_sequence_for<TRoles...>{}); }
+
     // --- Public API ---
-    template<typename T> static constexpr bool HasRole() { return IsTypeInPack<T, TRoles...>; }
-    template<typename T> static constexpr bool HasAttribute() { return IsTypeInPack<T, TAttributes...>; }
+    template<typename T> static constexpr bool HasRole() { return Contains<RolesList, T>; }
+    template<typename T> static constexpr bool HasAttribute() { return Contains<AttributesList, T>; }
 
     template<typename T>
     constexpr T& Role() {
         static_assert(HasRole<T>(), "Attempted to access a Role that does not exist on this Composition.");
-        return std::get<T>(RolesTuple);
+        return static_cast<CompositionDetail::Member<CompositionDetail::RoleTag, T>&>(Roles).Value;
+    }
+    template<typename T>
+    constexpr const T& Role() const {
+        static_assert(HasRole<T>(), "Attempted to access a Role that does not exist on this Composition.");
+        return static_cast<const CompositionDetail::Member<CompositionDetail::RoleTag, T>&>(Roles).Value;
+    }
+
+    // Access to a sibling Role from inside TSelf, e.g. from a Shooter:
+    // InHost.template Sibling<Shooter, Mover>(). Only Roles that TSelf requires
+    // are reachable, so the dependency stays declared. Like Role<T>(), it is a
+    // base class cast: a constant offset from the host, with no lookup.
+    template<typename TSelf, typename T>
+    constexpr T& Sibling() {
+        static_assert(HasRole<TSelf>(), "Composition Error: Sibling<TSelf, T>() is called for a Role that is not on this Composition.");
+        static_assert(RequiresRole<TSelf, T>, "Role Error: A Role accesses a sibling Role that it does not list in RequiredRoles.");
+        return Role<T>();
+    }
+    template<typename TSelf, typename T>
+    constexpr const T& Sibling() const {
+        static_assert(HasRole<TSelf>(), "Composition Error: Sibling<TSelf, T>() is called for a Role that is not on this Composition.");
+        static_assert(RequiresRole<TSelf, T>, "Role Error: A Role accesses a sibling Role that it does not list in RequiredRoles.");
+        return Role<T>();
     }
-    // ... const overload for Role()
-    
+
     template<typename T>
     constexpr T& Attribute() {
         static_assert(HasAttribute<T>(), "Attempted to access an Attribute that does not exist on this Composition.");
-        return std::get<T>(AttributesTuple);
+        return static_cast<CompositionDetail::Member<CompositionDetail::AttributeTag, T>&>(Attributes).Value;
+    }
+    template<typename T>
+    constexpr const T& Attribute() const {
+        static_assert(HasAttribute<T>(), "Attempted to access an Attribute that does not exist on this Composition.");
+        return static_cast<const CompositionDetail::Member<CompositionDetail::AttributeTag, T>&>(Attributes).Value;
     }
-    // ... const overload for Attribute()
 };
 
 
@@ -99,15 +305,20 @@ class Logger : public Role {
     // This role has no dependencies, so it implicitly uses the default
     // 'using RequiredAttributes = TypeList<>;' from the base Role struct.
 public:
-    explicit Logger(const std::string& DefaultContext) : Context(DefaultContext) {}
+    explicit Logger(std::string DefaultContext) : Context(std::move(DefaultContext)) {}
     template<typename HostType>
     void Log(const HostType& InHost, const std::string& Message) const {
         std::string CategoryName = Context;
-        if constexpr (HostType::HasAttribute<Category>()) {
-            CategoryName = InHost.Attribute<Category>().GetName();
+        if constexpr (HostType::template HasAttribute<Category>()) {
+            CategoryName = InHost.template Attribute<Category>().GetName();
         }
         std::cout << "[" << CategoryName << "] " << Message << std::endl;
     }
+    // Lifecycle hooks, found by concept. Mover and Shooter define none.
+    template<typename HostType>
+    void OnCreate(HostType& InHost) { Log(InHost, "Created."); }
+    template<typename HostType>
+    void OnDestroy(HostType& InHost) { Log(InHost, "Destroyed."); }
 private:
     std::string Context;
 };
@@ -118,33 +329,56 @@ public:
     using RequiredAttributes = TypeList<Transform>;
     template<typename HostType>
     void MoveX(HostType& InHost, float DeltaX) {
-        InHost.Attribute<Transform>().X += DeltaX;
+        InHost.template Attribute<Transform>().X += DeltaX;
+    }
+};
+
+class Shooter : public Role {
+public:
+    // Requiring Mover also requires its Transform, without repeating it here.
+    using RequiredRoles = TypeList<Mover, Logger>;
+    template<typename HostType>
+    void Fire(HostType& InHost) {
+        // Recoil pushes the shooter back through its sibling Mover.
+        InHost.template Sibling<Shooter, Mover>().MoveX(InHost, -1.0f);
+        InHost.template Sibling<Shooter, Logger>().Log(InHost, "Fired.");
+        ++ShotsFired;
     }
+    int ShotsFired = 0;
 };
 
 // --- 3. Define a Concrete Object using Composition ---
 class Player : public Composition<Player,
-    TypeList<Logger, Mover>,
+    TypeList<Logger, Mover, Shooter>,
     TypeList<Transform, Category>
 >
 {
 public:
-    Player(const std::string& InName)
-        // FIXED: The constructor call is now clean and direct.
-        : Composition(
-            Logger(InName), Mover(), // Roles are passed directly
-            Transform{100.0f, 0, 0}, Category{} // Attributes are passed directly
+    explicit Player(const std::string& InName)
+        // Each member is built once, directly from its own arguments. Mover
+        // and Shooter have no InPlace<>() and are default-constructed.
+        : Composition(std::piecewise_construct,
+            InPlace<Logger>(InName),
+            InPlace<Transform>(100.0f, 0.0f, 0.0f),
+            InPlace<Category>(InName)
         )
     {
-        Attribute<Category>().SetName(InName);
+        RunOnCreate();
     }
+    ~Player() { RunOnDestroy(); }
 
     void Update() {
         Role<Mover>().MoveX(*this, 5.0f);
+        Role<Shooter>().Fire(*this);
         Role<Logger>().Log(*this, "Update Finished.");
     }
 };
 
+// A Composition listing Shooter but not Mover fails to compile:
+// "A Role requires another Role ... that is not in this Composition."
+static_assert(RequiresRole<Shooter, Mover> && !RequiresRole<Mover, Shooter>);
+static_assert(std::is_same_v<RoleClosure<TypeList<Shooter>>, TypeList<Shooter, Mover, Logger>>);
+
 // --- 4. Main function to run the example ---
 int main() {
     Player MyPlayer("Test");
@@ -154,3 +388,4 @@ int main() {
 
 #endif // COMPOSITION_ENABLE_EXAMPLES
 
+#endif // ROLE_BASED_DESIGN_CPP
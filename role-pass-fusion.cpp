@@ -0,0 +1,233 @@
+#ifndef ROLE_PASS_FUSION_CPP
+#define ROLE_PASS_FUSION_CPP
+
+#include "composition-pool.cpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// --- Tier 4: Fused Role Passes ---
+// An update made of several Roles, e.g. Mover then Bounds, is naturally
+// written as one pass over the pool per Role. Each pass then streams the same
+// chunks through the cache again. RunFused() composes the passes at compile
+// time into a single loop per chunk that runs every pass on an instance
+// before moving on to the next one.
+//
+// A pass is a Role with Update(Host&, Args...). Its access set is its
+// RequiredAttributes, and the host only lets it reach those Attributes of its
+// own instance. Attributes also listed in ReadOnlyAttributes are handed out
+// as const and not stamped as changed. Because no pass can see another
+// instance, running the passes back to back per instance gives the same
+// result as running each over the whole pool. The fused loop resolves the
+// columns of the union of all access sets once per chunk, and stamps each
+// written column once per chunk.
+//
+// A pass that needs every instance processed by an earlier pass first (e.g.
+// it reads an accumulator that pass fills) does not fit this model. Run it in
+// a separate RunFused() call.
+
+namespace PassFusionDetail {
+    template <typename TRole>
+    struct ReadOnlyOf {
+        using Type = TypeList<>;
+    };
+    template <typename TRole>
+        requires requires { typename TRole::ReadOnlyAttributes; }
+    struct ReadOnlyOf<TRole> {
+        using Type = typename TRole::ReadOnlyAttributes;
+    };
+
+    // The column pointers of one chunk for the Attributes in TColumns.
+    template <typename TColumns>
+    struct ChunkColumns {
+        std::array<std::byte*, ListSize<TColumns>> Bases;
+    };
+} // namespace PassFusionDetail
+
+// What a pass sees as its host: one instance, restricted to its access set.
+template <typename TRole, typename TColumns>
+class PassHost {
+public:
+    using Reads  = typename TRole::RequiredAttributes;
+    using Consts = typename PassFusionDetail::ReadOnlyOf<TRole>::Type;
+
+    PassHost(const PassFusionDetail::ChunkColumns<TColumns>& InColumns, std::uint32_t InSlot) : Columns(InColumns), Slot(InSlot) {}
+
+    template <typename T>
+    static constexpr bool HasAttribute() { return Contains<Reads, T>; }
+
+    template <typename T>
+    auto& Attribute() const {
+        static_assert(HasAttribute<T>(), "Pass Error: A pass accesses an Attribute outside its RequiredAttributes.");
+        T* Column = std::launder(reinterpret_cast<T*>(Columns.Bases[IndexOf<TColumns, T>]));
+        if constexpr (Contains<Consts, T>) return static_cast<const T&>(Column[Slot]);
+        else return Column[Slot];
+    }
+
+private:
+    const PassFusionDetail::ChunkColumns<TColumns>& Columns;
+    std::uint32_t Slot;
+};
+
+namespace PassFusionDetail {
+    template <typename TRole>
+    using Writes = Difference<typename TRole::RequiredAttributes, typename ReadOnlyOf<TRole>::Type>;
+
+    template <typename TPool, typename TColumns, typename TWritten>
+    struct ColumnResolver;
+    template <typename TPool, typename... TColumns, typename TWritten>
+    struct ColumnResolver<TPool, TypeList<TColumns...>, TWritten> {
+        static ChunkColumns<TypeList<TColumns...>> Resolve(TPool& Pool, std::size_t ChunkIndex) {
+            return { { ColumnOf<TColumns>(Pool, ChunkIndex)... } };
+        }
+
+        template <typename T>
+        static std::byte* ColumnOf(TPool& Pool, std::size_t ChunkIndex) {
+            constexpr std::size_t Column = TPool::template ColumnIndex<T>;
+            if constexpr (Contains<TWritten, T>) return Pool.MutableColumnBytes(ChunkIndex, Column);
+            else return const_cast<std::byte*>(Pool.ColumnBytes(ChunkIndex, Column));
+        }
+    };
+
+    template <typename TColumns, typename TPass, typename... TArgs>
+    void RunPass(TPass& Pass, const ChunkColumns<TColumns>& Resolved, std::uint32_t Slot, const TArgs&... Arguments) {
+        PassHost<TPass, TColumns> Host(Resolved, Slot);
+        Pass.Update(Host, Arguments...);
+    }
+
+    template <typename TPool, typename... TPasses>
+    void CheckPasses() {
+        using PoolAttributes = typename TPool::CompositionType::AttributesList;
+        static_assert((ContainsAll<PoolAttributes, typename TPasses::RequiredAttributes> && ...),
+            "Pass Error: A pass requires an Attribute that the pool does not store.");
+        static_assert((ContainsAll<typename TPasses::RequiredAttributes, typename ReadOnlyOf<TPasses>::Type> && ...),
+            "Pass Error: ReadOnlyAttributes must be a subset of RequiredAttributes.");
+        static_assert(ListSize<Unique<TypeList<TPasses...>>> == sizeof...(TPasses),
+            "Pass Error: A pass is listed more than once.");
+    }
+} // namespace PassFusionDetail
+
+// Runs Passes[0].Update(Host, Args...), Passes[1].Update(Host, Args...), ...
+// on every instance in one loop per chunk.
+template <typename TPool, typename... TPasses, typename... TArgs>
+void RunFused(TPool& Pool, std::tuple<TPasses&...> Passes, const TArgs&... Arguments) {
+    using namespace PassFusionDetail;
+    CheckPasses<TPool, TPasses...>();
+    using Columns = Unique<Concat<typename TPasses::RequiredAttributes...>>;
+    using Written = Unique<Concat<Writes<TPasses>...>>;
+
+    for (std::size_t ChunkIndex = 0; ChunkIndex < Pool.ChunkCount(); ++ChunkIndex) {
+        const std::uint32_t Count = Pool.ChunkSize(ChunkIndex);
+        if (Count == 0) continue;
+        const ChunkColumns<Columns> Resolved = ColumnResolver<TPool, Columns, Written>::Resolve(Pool, ChunkIndex);
+        for (std::uint32_t Slot = 0; Slot < Count; ++Slot) {
+            std::apply([&](auto&... Pass) { (RunPass<Columns>(Pass, Resolved, Slot, Arguments...), ...); }, Passes);
+        }
+    }
+}
+
+// The unfused equivalent: one full loop over the pool per pass. Kept for
+// passes that must not be fused and for comparison.
+template <typename TPool, typename... TPasses, typename... TArgs>
+void RunSeparately(TPool& Pool, std::tuple<TPasses&...> Passes, const TArgs&... Arguments) {
+    std::apply([&](TPasses&... Pass) { (RunFused(Pool, std::tuple<TPasses&>(Pass), Arguments...), ...); }, Passes);
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef PASS_FUSION_ENABLE_EXAMPLES
+
+#include <chrono>
+
+struct Transform : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Velocity : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Health : public Attribute {
+    int Points = 100;
+};
+
+class Mover : public Role {
+public:
+    using RequiredAttributes = TypeList<Transform, Velocity>;
+    using ReadOnlyAttributes = TypeList<Velocity>;
+    template <typename HostType>
+    void Update(HostType& InHost, float DeltaTime) {
+        Transform& Position = InHost.template Attribute<Transform>();
+        const Velocity& Speed = InHost.template Attribute<Velocity>();
+        Position.X += Speed.X * DeltaTime;
+        Position.Y += Speed.Y * DeltaTime;
+        Position.Z += Speed.Z * DeltaTime;
+    }
+};
+
+// Keeps objects inside the arena and bounces them off its walls.
+class Bounds : public Role {
+public:
+    using RequiredAttributes = TypeList<Transform, Velocity>;
+    template <typename HostType>
+    void Update(HostType& InHost, float) {
+        Transform& Position = InHost.template Attribute<Transform>();
+        Velocity& Speed = InHost.template Attribute<Velocity>();
+        if (Position.X > Extent || Position.X < -Extent) Speed.X = -Speed.X;
+        if (Position.Z > Extent || Position.Z < -Extent) Speed.Z = -Speed.Z;
+    }
+    float Extent = 1000.0f;
+};
+
+class Drag : public Role {
+public:
+    using RequiredAttributes = TypeList<Velocity>;
+    template <typename HostType>
+    void Update(HostType& InHost, float DeltaTime) {
+        Velocity& Speed = InHost.template Attribute<Velocity>();
+        const float Keep = 1.0f - 0.1f * DeltaTime;
+        Speed.X *= Keep;
+        Speed.Y *= Keep;
+        Speed.Z *= Keep;
+    }
+};
+
+class Ball : public Composition<Ball, TypeList<Mover, Bounds, Drag>, TypeList<Transform, Velocity, Health>> {};
+
+using BallPool = CompositionPool<Ball>;
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    constexpr int Count = 2000000, Frames = 10;
+
+    BallPool Separate, Fused;
+    for (int Index = 0; Index < Count; ++Index) {
+        const Velocity Start{{}, float(Index % 7) - 3.0f, 0.0f, float(Index % 5) - 2.0f};
+        Separate.Spawn(Transform{}, Start, Health{});
+        Fused.Spawn(Transform{}, Start, Health{});
+    }
+    Mover Move;
+    Bounds Walls;
+    Drag Damping;
+
+    const auto Time = [&](auto&& Run) {
+        const auto Start = Clock::now();
+        for (int Frame = 0; Frame < Frames; ++Frame) Run();
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - Start).count() / Frames;
+    };
+    const auto SeparateTime = Time([&] { RunSeparately(Separate, std::tie(Move, Walls, Damping), 0.016f); });
+    const auto FusedTime = Time([&] { RunFused(Fused, std::tie(Move, Walls, Damping), 0.016f); });
+
+    bool Same = true;
+    for (std::size_t Index = 0; Index < Fused.Size(); Index += 997) {
+        Same = Same && Fused.Attribute<Transform>(Index).X == Separate.Attribute<Transform>(Index).X
+                    && Fused.Attribute<Velocity>(Index).Z == Separate.Attribute<Velocity>(Index).Z;
+    }
+    std::cout << "Mover + Bounds + Drag over " << Count << " balls: " << SeparateTime << " us as three passes, "
+              << FusedTime << " us fused (results " << (Same ? "identical" : "differ") << ")" << std::endl;
+    return 0;
+}
+
+#endif // PASS_FUSION_ENABLE_EXAMPLES
+
+#endif // ROLE_PASS_FUSION_CPP
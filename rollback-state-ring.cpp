@@ -0,0 +1,253 @@
+#ifndef ROLLBACK_STATE_RING_CPP
+#define ROLLBACK_STATE_RING_CPP
+
+#include "composition-pool.cpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// --- Tier 4: Rollback State Ring ---
+// Keeps the last FrameCount frames of a CompositionPool so netcode can rewind
+// and resimulate. SaveFrame() copies only the chunks stamped since the
+// previous save, and Rollback() only rewrites chunks that changed after the
+// target frame. Both still read every chunk's version to find them, so they
+// cost O(chunks) version compares plus O(changed chunks) copies.
+//
+// Each chunk remembers one copy per ring slot plus a baseline: the newest copy
+// at or before the oldest frame still in the ring. When a slot is reused, its
+// copies are swapped into the baseline instead of being copied again.
+//
+// Every frame also records the pool's chunk count. Rollback() resizes the
+// pool to it before restoring, so chunks dropped since (Clear(),
+// ReleaseChunks()) come back, and chunks added since go away.
+//
+// Chunks are picked by their version stamps rather than the pool's changed
+// list, so other code (a replicator, a persistent store) may call
+// AdvanceVersion() between saves without hiding changes from the ring.
+
+template <typename TPool, std::size_t FrameCount = 8>
+class RollbackRing {
+public:
+    using Chunk = typename TPool::Chunk;
+
+    static_assert(FrameCount > 0, "RollbackRing Error: FrameCount must be non-zero.");
+
+    // Captures the pool's current contents as frame 0.
+    explicit RollbackRing(TPool& InPool) : Pool(InPool), BaselineChunkCount(InPool.ChunkCount()) {
+        GrowHistory();
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Pool.ChunkCount(); ++ChunkIndex) {
+            *History[ChunkIndex].Baseline = Pool.GetChunk(ChunkIndex);
+        }
+        Pool.AdvanceVersion();
+        SavedVersion = Pool.Version();
+    }
+
+    RollbackRing(const RollbackRing&) = delete;
+    RollbackRing& operator=(const RollbackRing&) = delete;
+
+    // Records the pool's state as a new frame and returns its number.
+    std::uint64_t SaveFrame() {
+        GrowHistory();
+        const std::uint64_t Frame = Latest + 1;
+        const std::size_t SlotIndex = Frame % FrameCount;
+        FrameSlot& Slot = Slots[SlotIndex];
+
+        // The slot still holds the frame falling out of the window: its copies
+        // become the new baseline.
+        if (Slot.Frame != 0) {
+            for (const std::uint32_t ChunkIndex : Slot.ChunkIndices) {
+                ChunkHistory& Entry = History[ChunkIndex];
+                std::swap(Entry.Baseline, Entry.Copies[SlotIndex]);
+                Entry.CopyFrames[SlotIndex] = 0;
+            }
+            Oldest = Slot.Frame;
+            BaselineChunkCount = Slot.ChunkCount;
+        }
+
+        Slot.Frame = Frame;
+        Slot.ChunkCount = Pool.ChunkCount();
+        Slot.ChunkIndices.clear();
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Pool.ChunkCount(); ++ChunkIndex) {
+            if (Pool.ChunkVersion(ChunkIndex) >= SavedVersion) Slot.ChunkIndices.push_back(static_cast<std::uint32_t>(ChunkIndex));
+        }
+        for (const std::uint32_t ChunkIndex : Slot.ChunkIndices) {
+            ChunkHistory& Entry = History[ChunkIndex];
+            if (!Entry.Copies[SlotIndex]) Entry.Copies[SlotIndex] = std::make_unique<Chunk>();
+            *Entry.Copies[SlotIndex] = Pool.GetChunk(ChunkIndex);
+            Entry.CopyFrames[SlotIndex] = Frame;
+        }
+
+        Latest = Frame;
+        Pool.AdvanceVersion();
+        SavedVersion = Pool.Version();
+        return Frame;
+    }
+
+    // Restores the pool to the state recorded by SaveFrame(Frame) and drops
+    // every newer frame. Returns false if Frame is no longer in the ring.
+    bool Rollback(std::uint64_t Frame) {
+        if (Frame < Oldest || Frame > Latest) return false;
+        ++RestoreEpoch;
+
+        // Chunks appended here are stamped, so the unsaved pass restores them.
+        const std::size_t SavedChunkCount = Frame == Oldest ? BaselineChunkCount : Slots[Frame % FrameCount].ChunkCount;
+        Pool.ResizeChunks(SavedChunkCount);
+        GrowHistory();
+
+        // Unsaved changes first: restoring stamps chunks too.
+        for (std::size_t ChunkIndex = 0; ChunkIndex < SavedChunkCount; ++ChunkIndex) {
+            if (Pool.ChunkVersion(ChunkIndex) >= SavedVersion) RestoreChunk(static_cast<std::uint32_t>(ChunkIndex), Frame);
+        }
+        for (std::uint64_t Newer = Frame + 1; Newer <= Latest; ++Newer) {
+            for (const std::uint32_t ChunkIndex : Slots[Newer % FrameCount].ChunkIndices) {
+                if (ChunkIndex < SavedChunkCount) RestoreChunk(ChunkIndex, Frame);
+            }
+        }
+
+        for (std::uint64_t Newer = Frame + 1; Newer <= Latest; ++Newer) {
+            const std::size_t SlotIndex = Newer % FrameCount;
+            for (const std::uint32_t ChunkIndex : Slots[SlotIndex].ChunkIndices) {
+                History[ChunkIndex].CopyFrames[SlotIndex] = 0;
+            }
+            Slots[SlotIndex].Frame = 0;
+            Slots[SlotIndex].ChunkIndices.clear();
+        }
+
+        Latest = Frame;
+        Pool.AdvanceVersion();
+        SavedVersion = Pool.Version();
+        return true;
+    }
+
+    std::uint64_t LatestFrame() const { return Latest; }
+    std::uint64_t OldestFrame() const { return Oldest; }
+
+private:
+    struct FrameSlot {
+        std::uint64_t Frame = 0;
+        std::size_t ChunkCount = 0;
+        std::vector<std::uint32_t> ChunkIndices;
+    };
+
+    struct ChunkHistory {
+        std::unique_ptr<Chunk> Baseline = std::make_unique<Chunk>();
+        std::array<std::unique_ptr<Chunk>, FrameCount> Copies;
+        std::array<std::uint64_t, FrameCount> CopyFrames{};
+        std::uint64_t RestoredEpoch = 0;
+    };
+
+    void GrowHistory() {
+        while (History.size() < Pool.ChunkCount()) History.emplace_back();
+    }
+
+    void RestoreChunk(std::uint32_t ChunkIndex, std::uint64_t Frame) {
+        ChunkHistory& Entry = History[ChunkIndex];
+        if (Entry.RestoredEpoch == RestoreEpoch) return;
+        Entry.RestoredEpoch = RestoreEpoch;
+
+        const Chunk* Source = Entry.Baseline.get();
+        for (std::uint64_t Candidate = Frame; Candidate > Oldest; --Candidate) {
+            const std::size_t SlotIndex = Candidate % FrameCount;
+            if (Entry.CopyFrames[SlotIndex] == Candidate) {
+                Source = Entry.Copies[SlotIndex].get();
+                break;
+            }
+        }
+        Pool.RestoreChunk(ChunkIndex, *Source);
+    }
+
+    TPool& Pool;
+    std::array<FrameSlot, FrameCount> Slots;
+    std::vector<ChunkHistory> History;
+    std::size_t BaselineChunkCount; // Chunk count at frame Oldest.
+    std::uint64_t SavedVersion = 0; // Pool version right after the latest save.
+    std::uint64_t Latest = 0;
+    std::uint64_t Oldest = 0;
+    std::uint64_t RestoreEpoch = 0;
+};
+
+
+// --- EXAMPLE USAGE ---
+#ifdef ROLLBACK_ENABLE_EXAMPLES
+
+#include <chrono>
+
+struct Transform : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Velocity : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+
+class Body : public Composition<Body, TypeList<>, TypeList<Transform, Velocity>> {};
+
+using BodyPool = CompositionPool<Body>;
+
+// Moves the first AwakeCount bodies; the rest of the pool is asleep and is
+// never stamped, which is the common case rollback is optimized for.
+void Simulate(BodyPool& Pool, std::size_t AwakeCount, float DeltaTime) {
+    const std::size_t AwakeChunks = (AwakeCount + BodyPool::Capacity - 1) / BodyPool::Capacity;
+    for (std::size_t ChunkIndex = 0; ChunkIndex < AwakeChunks; ++ChunkIndex) {
+        Transform* Positions = Pool.MutableColumn<Transform>(ChunkIndex);
+        const Velocity* Velocities = Pool.Column<Velocity>(ChunkIndex);
+        for (std::uint32_t Slot = 0; Slot < Pool.ChunkSize(ChunkIndex); ++Slot) {
+            Positions[Slot].X += Velocities[Slot].X * DeltaTime;
+            Positions[Slot].Y += Velocities[Slot].Y * DeltaTime;
+        }
+    }
+}
+
+float SumX(const BodyPool& Pool) {
+    float Sum = 0.0f;
+    for (std::size_t Index = 0; Index < Pool.Size(); ++Index) Sum += Pool.Attribute<Transform>(Index).X;
+    return Sum;
+}
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t ObjectCount = 100000, AwakeCount = 10000;
+
+    BodyPool Pool;
+    for (std::size_t Index = 0; Index < ObjectCount; ++Index) {
+        Pool.Spawn(Transform{{}, float(Index), 0.0f, 0.0f}, Velocity{{}, 1.0f, 0.5f, 0.0f});
+    }
+    RollbackRing<BodyPool, 8> Ring(Pool);
+
+    std::array<float, 16> Checksums{};
+    Clock::duration SaveTime{};
+    for (int Step = 0; Step < 16; ++Step) {
+        Simulate(Pool, AwakeCount, 1.0f / 60.0f);
+        const auto Start = Clock::now();
+        const std::uint64_t Frame = Ring.SaveFrame();
+        SaveTime += Clock::now() - Start;
+        Checksums[Frame % Checksums.size()] = SumX(Pool);
+    }
+
+    // Mispredicted input: rewind to the oldest frame we still have.
+    const std::uint64_t Target = Ring.OldestFrame();
+    Simulate(Pool, AwakeCount, 1.0f); // Unsaved work that must be discarded too.
+    Pool.AdvanceVersion();             // e.g. a replicator finishing its tick.
+    Simulate(Pool, AwakeCount, 1.0f);
+    const auto Start = Clock::now();
+    const bool Restored = Ring.Rollback(Target);
+    const auto RollbackTime = Clock::now() - Start;
+
+    const bool Matches = SumX(Pool) == Checksums[Target % Checksums.size()];
+
+    // Clearing the pool drops its chunks; rolling back brings them back.
+    Pool.Clear();
+    const bool Refilled = Ring.Rollback(Target) && Pool.Size() == ObjectCount && SumX(Pool) == Checksums[Target % Checksums.size()];
+
+    using Micro = std::chrono::microseconds;
+    std::cout << "Rolled back to frame " << Target << ": " << (Restored ? "ok" : "out of window")
+              << ", state " << (Matches ? "matches" : "DIVERGED") << ", after Clear() " << (Refilled ? "matches" : "DIVERGED") << "\n"
+              << "Average SaveFrame: " << std::chrono::duration_cast<Micro>(SaveTime).count() / 16 << " us, "
+              << "Rollback: " << std::chrono::duration_cast<Micro>(RollbackTime).count() << " us" << std::endl;
+    return 0;
+}
+
+#endif // ROLLBACK_ENABLE_EXAMPLES
+
+#endif // ROLLBACK_STATE_RING_CPP
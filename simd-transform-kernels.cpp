@@ -0,0 +1,780 @@
+#ifndef SIMD_TRANSFORM_KERNELS_CPP
+#define SIMD_TRANSFORM_KERNELS_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_TRANSFORM_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit an instruction set inside functions that enable it,
+// so each kernel names its target and the file builds without -mavx flags.
+// MSVC emits any intrinsic anywhere.
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET(Isa) __attribute__((target(Isa)))
+#else
+#define SIMD_TARGET(Isa)
+#endif
+
+// GCC fuses a separate multiply and add into an FMA wherever the target has
+// one, which changes the rounding. Kernels whose results must match the
+// scalar bits opt out. Clang only fuses within one expression, and the
+// scalar kernels compute their products as separate statements.
+#if defined(__GNUC__) && !defined(__clang__)
+#define SIMD_NO_CONTRACT __attribute__((optimize("fp-contract=off")))
+#else
+#define SIMD_NO_CONTRACT
+#endif
+
+// --- Tier 0: SIMD Transform Kernels ---
+// Positions in bulk: translate, scale, distance to a point and bounding box,
+// over structure-of-arrays spans (separate X, Y and Z arrays). Translate and
+// scale also come in an interleaved form for columns of {X, Y, Z} structs,
+// which is how a pool stores a Transform Attribute.
+//
+// ComposeMatrices() turns translation, rotation and scale columns into 4x3
+// matrices, also one array per component, or interleaved.
+//
+// Each kernel exists for SSE2, AVX2 and AVX-512F and as portable scalar code.
+// TransformKernels() picks the widest set the CPU supports once, via cpuid,
+// and code calls through its table. KernelsFor() returns a specific set, for
+// benchmarks and tests. Every kernel handles any Count and any alignment; the
+// remainder past the last full vector runs the scalar code.
+
+enum class SimdLevel { Scalar, SSE2, AVX2, AVX512 };
+
+inline const char* SimdLevelName(SimdLevel Level) {
+    switch (Level) {
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512: return "AVX-512";
+        default: return "Scalar";
+    }
+}
+
+struct TransformSpan {
+    float* X;
+    float* Y;
+    float* Z;
+    std::size_t Count;
+};
+
+struct ConstTransformSpan {
+    const float* X;
+    const float* Y;
+    const float* Z;
+    std::size_t Count;
+
+    ConstTransformSpan(const float* InX, const float* InY, const float* InZ, std::size_t InCount) : X(InX), Y(InY), Z(InZ), Count(InCount) {}
+    ConstTransformSpan(const TransformSpan& Span) : X(Span.X), Y(Span.Y), Z(Span.Z), Count(Span.Count) {}
+};
+
+// Empty spans report Min = +infinity and Max = -infinity.
+struct TransformBounds {
+    float Min[3];
+    float Max[3];
+};
+
+// Count objects' translation, unit quaternion (X, Y, Z, W) and scale, one
+// array per component.
+struct TrsColumns {
+    const float* Position[3];
+    const float* Rotation[4];
+    const float* Scale[3];
+};
+
+// One 4x3 matrix per object, one array per element, row-major: the scaled
+// X, Y and Z axes, then the translation. A point P maps to P * M.
+struct MatrixColumns {
+    float* Elements[12];
+};
+
+struct TransformKernelTable {
+    SimdLevel Level;
+    void (*Translate)(TransformSpan Span, float DX, float DY, float DZ);
+    void (*Scale)(TransformSpan Span, float SX, float SY, float SZ);
+    // Separate multiplies and adds, never fused, so every set returns the
+    // scalar bits whatever -ffp-contract says.
+    void (*Distance)(ConstTransformSpan Span, float PX, float PY, float PZ, float* Out);
+    TransformBounds (*Bounds)(ConstTransformSpan Span);
+    // XYZ points at Count consecutive {X, Y, Z} triples.
+    void (*TranslateInterleaved)(float* XYZ, std::size_t Count, float DX, float DY, float DZ);
+    void (*ScaleInterleaved)(float* XYZ, std::size_t Count, float SX, float SY, float SZ);
+    // Multiplies and adds in the same order in every set, never fused, so all
+    // sets produce the same bits whatever -ffp-contract says.
+    void (*ComposeMatrices)(TrsColumns In, MatrixColumns Out, std::size_t Count);
+    // The same over Count consecutive {X, Y, Z} positions, {X, Y, Z, W}
+    // rotations and {X, Y, Z} scales, writing 12 consecutive floats per
+    // matrix. Bound by shuffles rather than arithmetic, so the wider sets use
+    // the SSE2 version.
+    void (*ComposeMatricesInterleaved)(const float* Positions, const float* Rotations, const float* Scales, float* Matrices, std::size_t Count);
+};
+
+namespace SimdTransformDetail {
+    // --- Scalar ---
+    // Also the tail of every vector kernel, from element First on.
+    inline void TranslateScalar(TransformSpan Span, float DX, float DY, float DZ, std::size_t First = 0) {
+        for (std::size_t Index = First; Index < Span.Count; ++Index) {
+            Span.X[Index] += DX;
+            Span.Y[Index] += DY;
+            Span.Z[Index] += DZ;
+        }
+    }
+
+    inline void ScaleScalar(TransformSpan Span, float SX, float SY, float SZ, std::size_t First = 0) {
+        for (std::size_t Index = First; Index < Span.Count; ++Index) {
+            Span.X[Index] *= SX;
+            Span.Y[Index] *= SY;
+            Span.Z[Index] *= SZ;
+        }
+    }
+
+    SIMD_NO_CONTRACT inline void DistanceScalar(ConstTransformSpan Span, float PX, float PY, float PZ, float* Out, std::size_t First = 0) {
+        for (std::size_t Index = First; Index < Span.Count; ++Index) {
+            const float DX = Span.X[Index] - PX, DY = Span.Y[Index] - PY, DZ = Span.Z[Index] - PZ;
+            const float SquaredX = DX * DX, SquaredY = DY * DY, SquaredZ = DZ * DZ;
+            Out[Index] = std::sqrt(SquaredX + SquaredY + SquaredZ);
+        }
+    }
+
+    inline void GrowBounds(ConstTransformSpan Span, TransformBounds& Bounds, std::size_t First) {
+        for (std::size_t Index = First; Index < Span.Count; ++Index) {
+            Bounds.Min[0] = std::min(Bounds.Min[0], Span.X[Index]);
+            Bounds.Min[1] = std::min(Bounds.Min[1], Span.Y[Index]);
+            Bounds.Min[2] = std::min(Bounds.Min[2], Span.Z[Index]);
+            Bounds.Max[0] = std::max(Bounds.Max[0], Span.X[Index]);
+            Bounds.Max[1] = std::max(Bounds.Max[1], Span.Y[Index]);
+            Bounds.Max[2] = std::max(Bounds.Max[2], Span.Z[Index]);
+        }
+    }
+
+    inline TransformBounds EmptyBounds() {
+        constexpr float Infinity = std::numeric_limits<float>::infinity();
+        return { { Infinity, Infinity, Infinity }, { -Infinity, -Infinity, -Infinity } };
+    }
+
+    inline TransformBounds BoundsScalar(ConstTransformSpan Span) {
+        TransformBounds Bounds = EmptyBounds();
+        GrowBounds(Span, Bounds, 0);
+        return Bounds;
+    }
+
+    // Interleaved triples are a flat float array whose per-element operand
+    // repeats every 3 floats.
+    inline void TranslateInterleavedScalar(float* XYZ, std::size_t Count, float DX, float DY, float DZ, std::size_t First = 0) {
+        for (std::size_t Index = First; Index < Count; ++Index) {
+            XYZ[Index * 3] += DX;
+            XYZ[Index * 3 + 1] += DY;
+            XYZ[Index * 3 + 2] += DZ;
+        }
+    }
+
+    inline void ScaleInterleavedScalar(float* XYZ, std::size_t Count, float SX, float SY, float SZ, std::size_t First = 0) {
+        for (std::size_t Index = First; Index < Count; ++Index) {
+            XYZ[Index * 3] *= SX;
+            XYZ[Index * 3 + 1] *= SY;
+            XYZ[Index * 3 + 2] *= SZ;
+        }
+    }
+
+    SIMD_NO_CONTRACT inline void ComposeMatricesScalar(TrsColumns In, MatrixColumns Out, std::size_t Count, std::size_t First = 0) {
+        for (std::size_t Index = First; Index < Count; ++Index) {
+            const float X = In.Rotation[0][Index], Y = In.Rotation[1][Index], Z = In.Rotation[2][Index], W = In.Rotation[3][Index];
+            const float X2 = X + X, Y2 = Y + Y, Z2 = Z + Z;
+            const float XX = X * X2, YY = Y * Y2, ZZ = Z * Z2, XY = X * Y2, XZ = X * Z2, YZ = Y * Z2;
+            const float WX = W * X2, WY = W * Y2, WZ = W * Z2;
+            const float SX = In.Scale[0][Index], SY = In.Scale[1][Index], SZ = In.Scale[2][Index];
+            Out.Elements[0][Index] = (1.0f - (YY + ZZ)) * SX;
+            Out.Elements[1][Index] = (XY + WZ) * SX;
+            Out.Elements[2][Index] = (XZ - WY) * SX;
+            Out.Elements[3][Index] = (XY - WZ) * SY;
+            Out.Elements[4][Index] = (1.0f - (XX + ZZ)) * SY;
+            Out.Elements[5][Index] = (YZ + WX) * SY;
+            Out.Elements[6][Index] = (XZ + WY) * SZ;
+            Out.Elements[7][Index] = (YZ - WX) * SZ;
+            Out.Elements[8][Index] = (1.0f - (XX + YY)) * SZ;
+            Out.Elements[9][Index] = In.Position[0][Index];
+            Out.Elements[10][Index] = In.Position[1][Index];
+            Out.Elements[11][Index] = In.Position[2][Index];
+        }
+    }
+
+    SIMD_NO_CONTRACT inline void ComposeMatricesInterleavedScalar(const float* Positions, const float* Rotations, const float* Scales, float* Matrices,
+                                                                  std::size_t Count, std::size_t First = 0) {
+        for (std::size_t Index = First; Index < Count; ++Index) {
+            const TrsColumns In{ { Positions + Index * 3, Positions + Index * 3 + 1, Positions + Index * 3 + 2 },
+                                 { Rotations + Index * 4, Rotations + Index * 4 + 1, Rotations + Index * 4 + 2, Rotations + Index * 4 + 3 },
+                                 { Scales + Index * 3, Scales + Index * 3 + 1, Scales + Index * 3 + 2 } };
+            MatrixColumns Out;
+            for (std::size_t Element = 0; Element < 12; ++Element) Out.Elements[Element] = Matrices + Index * 12 + Element;
+            ComposeMatricesScalar(In, Out, 1);
+        }
+    }
+
+    // Three consecutive vectors of Width lanes cover Width whole triples, so
+    // the operand pattern is the same three vectors at every step.
+    template <std::size_t Width>
+    struct Pattern {
+        alignas(64) float Lanes[3 * Width];
+        Pattern(float A, float B, float C) {
+            for (std::size_t Lane = 0; Lane < 3 * Width; Lane += 3) {
+                Lanes[Lane] = A;
+                Lanes[Lane + 1] = B;
+                Lanes[Lane + 2] = C;
+            }
+        }
+    };
+
+#ifdef SIMD_TRANSFORM_X86
+    // --- SSE2 ---
+    SIMD_TARGET("sse2") inline void TranslateSSE2(TransformSpan Span, float DX, float DY, float DZ) {
+        const __m128 VX = _mm_set1_ps(DX), VY = _mm_set1_ps(DY), VZ = _mm_set1_ps(DZ);
+        std::size_t Index = 0;
+        for (; Index + 4 <= Span.Count; Index += 4) {
+            _mm_storeu_ps(Span.X + Index, _mm_add_ps(_mm_loadu_ps(Span.X + Index), VX));
+            _mm_storeu_ps(Span.Y + Index, _mm_add_ps(_mm_loadu_ps(Span.Y + Index), VY));
+            _mm_storeu_ps(Span.Z + Index, _mm_add_ps(_mm_loadu_ps(Span.Z + Index), VZ));
+        }
+        TranslateScalar(Span, DX, DY, DZ, Index);
+    }
+
+    SIMD_TARGET("sse2") inline void ScaleSSE2(TransformSpan Span, float SX, float SY, float SZ) {
+        const __m128 VX = _mm_set1_ps(SX), VY = _mm_set1_ps(SY), VZ = _mm_set1_ps(SZ);
+        std::size_t Index = 0;
+        for (; Index + 4 <= Span.Count; Index += 4) {
+            _mm_storeu_ps(Span.X + Index, _mm_mul_ps(_mm_loadu_ps(Span.X + Index), VX));
+            _mm_storeu_ps(Span.Y + Index, _mm_mul_ps(_mm_loadu_ps(Span.Y + Index), VY));
+            _mm_storeu_ps(Span.Z + Index, _mm_mul_ps(_mm_loadu_ps(Span.Z + Index), VZ));
+        }
+        ScaleScalar(Span, SX, SY, SZ, Index);
+    }
+
+    SIMD_TARGET("sse2") SIMD_NO_CONTRACT inline void DistanceSSE2(ConstTransformSpan Span, float PX, float PY, float PZ, float* Out) {
+        const __m128 VX = _mm_set1_ps(PX), VY = _mm_set1_ps(PY), VZ = _mm_set1_ps(PZ);
+        std::size_t Index = 0;
+        for (; Index + 4 <= Span.Count; Index += 4) {
+            const __m128 DX = _mm_sub_ps(_mm_loadu_ps(Span.X + Index), VX);
+            const __m128 DY = _mm_sub_ps(_mm_loadu_ps(Span.Y + Index), VY);
+            const __m128 DZ = _mm_sub_ps(_mm_loadu_ps(Span.Z + Index), VZ);
+            const __m128 Squared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(DX, DX), _mm_mul_ps(DY, DY)), _mm_mul_ps(DZ, DZ));
+            _mm_storeu_ps(Out + Index, _mm_sqrt_ps(Squared));
+        }
+        DistanceScalar(Span, PX, PY, PZ, Out, Index);
+    }
+
+    SIMD_TARGET("sse2") inline float ReduceMinSSE2(__m128 Value) {
+        Value = _mm_min_ps(Value, _mm_shuffle_ps(Value, Value, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_cvtss_f32(_mm_min_ps(Value, _mm_shuffle_ps(Value, Value, _MM_SHUFFLE(2, 3, 0, 1))));
+    }
+    SIMD_TARGET("sse2") inline float ReduceMaxSSE2(__m128 Value) {
+        Value = _mm_max_ps(Value, _mm_shuffle_ps(Value, Value, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_cvtss_f32(_mm_max_ps(Value, _mm_shuffle_ps(Value, Value, _MM_SHUFFLE(2, 3, 0, 1))));
+    }
+
+    SIMD_TARGET("sse2") inline TransformBounds BoundsSSE2(ConstTransformSpan Span) {
+        TransformBounds Bounds = EmptyBounds();
+        if (Span.Count < 4) return GrowBounds(Span, Bounds, 0), Bounds;
+        __m128 MinX = _mm_loadu_ps(Span.X), MinY = _mm_loadu_ps(Span.Y), MinZ = _mm_loadu_ps(Span.Z);
+        __m128 MaxX = MinX, MaxY = MinY, MaxZ = MinZ;
+        std::size_t Index = 4;
+        for (; Index + 4 <= Span.Count; Index += 4) {
+            const __m128 X = _mm_loadu_ps(Span.X + Index), Y = _mm_loadu_ps(Span.Y + Index), Z = _mm_loadu_ps(Span.Z + Index);
+            MinX = _mm_min_ps(MinX, X); MaxX = _mm_max_ps(MaxX, X);
+            MinY = _mm_min_ps(MinY, Y); MaxY = _mm_max_ps(MaxY, Y);
+            MinZ = _mm_min_ps(MinZ, Z); MaxZ = _mm_max_ps(MaxZ, Z);
+        }
+        Bounds = { { ReduceMinSSE2(MinX), ReduceMinSSE2(MinY), ReduceMinSSE2(MinZ) },
+                   { ReduceMaxSSE2(MaxX), ReduceMaxSSE2(MaxY), ReduceMaxSSE2(MaxZ) } };
+        GrowBounds(Span, Bounds, Index);
+        return Bounds;
+    }
+
+    SIMD_TARGET("sse2") inline void TranslateInterleavedSSE2(float* XYZ, std::size_t Count, float DX, float DY, float DZ) {
+        const Pattern<4> Offsets(DX, DY, DZ);
+        const __m128 P0 = _mm_load_ps(Offsets.Lanes), P1 = _mm_load_ps(Offsets.Lanes + 4), P2 = _mm_load_ps(Offsets.Lanes + 8);
+        std::size_t Index = 0;
+        for (; Index + 4 <= Count; Index += 4) {
+            float* At = XYZ + Index * 3;
+            _mm_storeu_ps(At, _mm_add_ps(_mm_loadu_ps(At), P0));
+            _mm_storeu_ps(At + 4, _mm_add_ps(_mm_loadu_ps(At + 4), P1));
+            _mm_storeu_ps(At + 8, _mm_add_ps(_mm_loadu_ps(At + 8), P2));
+        }
+        TranslateInterleavedScalar(XYZ, Count, DX, DY, DZ, Index);
+    }
+
+    SIMD_TARGET("sse2") inline void ScaleInterleavedSSE2(float* XYZ, std::size_t Count, float SX, float SY, float SZ) {
+        const Pattern<4> Factors(SX, SY, SZ);
+        const __m128 P0 = _mm_load_ps(Factors.Lanes), P1 = _mm_load_ps(Factors.Lanes + 4), P2 = _mm_load_ps(Factors.Lanes + 8);
+        std::size_t Index = 0;
+        for (; Index + 4 <= Count; Index += 4) {
+            float* At = XYZ + Index * 3;
+            _mm_storeu_ps(At, _mm_mul_ps(_mm_loadu_ps(At), P0));
+            _mm_storeu_ps(At + 4, _mm_mul_ps(_mm_loadu_ps(At + 4), P1));
+            _mm_storeu_ps(At + 8, _mm_mul_ps(_mm_loadu_ps(At + 8), P2));
+        }
+        ScaleInterleavedScalar(XYZ, Count, SX, SY, SZ, Index);
+    }
+
+    // The nine basis elements of four matrices, one vector per element.
+    SIMD_TARGET("sse2") SIMD_NO_CONTRACT inline void ComposeBasisSSE2(__m128 X, __m128 Y, __m128 Z, __m128 W, __m128 SX, __m128 SY, __m128 SZ, __m128* Basis) {
+        const __m128 One = _mm_set1_ps(1.0f);
+        const __m128 X2 = _mm_add_ps(X, X), Y2 = _mm_add_ps(Y, Y), Z2 = _mm_add_ps(Z, Z);
+        const __m128 XX = _mm_mul_ps(X, X2), YY = _mm_mul_ps(Y, Y2), ZZ = _mm_mul_ps(Z, Z2);
+        const __m128 XY = _mm_mul_ps(X, Y2), XZ = _mm_mul_ps(X, Z2), YZ = _mm_mul_ps(Y, Z2);
+        const __m128 WX = _mm_mul_ps(W, X2), WY = _mm_mul_ps(W, Y2), WZ = _mm_mul_ps(W, Z2);
+        Basis[0] = _mm_mul_ps(_mm_sub_ps(One, _mm_add_ps(YY, ZZ)), SX);
+        Basis[1] = _mm_mul_ps(_mm_add_ps(XY, WZ), SX);
+        Basis[2] = _mm_mul_ps(_mm_sub_ps(XZ, WY), SX);
+        Basis[3] = _mm_mul_ps(_mm_sub_ps(XY, WZ), SY);
+        Basis[4] = _mm_mul_ps(_mm_sub_ps(One, _mm_add_ps(XX, ZZ)), SY);
+        Basis[5] = _mm_mul_ps(_mm_add_ps(YZ, WX), SY);
+        Basis[6] = _mm_mul_ps(_mm_add_ps(XZ, WY), SZ);
+        Basis[7] = _mm_mul_ps(_mm_sub_ps(YZ, WX), SZ);
+        Basis[8] = _mm_mul_ps(_mm_sub_ps(One, _mm_add_ps(XX, YY)), SZ);
+    }
+
+    SIMD_TARGET("sse2") SIMD_NO_CONTRACT inline void ComposeMatricesSSE2(TrsColumns In, MatrixColumns Out, std::size_t Count) {
+        std::size_t Index = 0;
+        for (; Index + 4 <= Count; Index += 4) {
+            __m128 Basis[9];
+            ComposeBasisSSE2(_mm_loadu_ps(In.Rotation[0] + Index), _mm_loadu_ps(In.Rotation[1] + Index), _mm_loadu_ps(In.Rotation[2] + Index),
+                             _mm_loadu_ps(In.Rotation[3] + Index), _mm_loadu_ps(In.Scale[0] + Index), _mm_loadu_ps(In.Scale[1] + Index),
+                             _mm_loadu_ps(In.Scale[2] + Index), Basis);
+            for (std::size_t Element = 0; Element < 9; ++Element) _mm_storeu_ps(Out.Elements[Element] + Index, Basis[Element]);
+            for (std::size_t Axis = 0; Axis < 3; ++Axis) {
+                _mm_storeu_ps(Out.Elements[9 + Axis] + Index, _mm_loadu_ps(In.Position[Axis] + Index));
+            }
+        }
+        ComposeMatricesScalar(In, Out, Count, Index);
+    }
+
+    // Four {X, Y, Z} triples (three vectors) to one vector per axis.
+    SIMD_TARGET("sse2") inline void SplitTriplesSSE2(const float* Triples, __m128& X, __m128& Y, __m128& Z) {
+        const __m128 A = _mm_loadu_ps(Triples), B = _mm_loadu_ps(Triples + 4), C = _mm_loadu_ps(Triples + 8);
+        const __m128 XY23 = _mm_shuffle_ps(B, C, _MM_SHUFFLE(2, 1, 3, 2));
+        const __m128 YZ01 = _mm_shuffle_ps(A, B, _MM_SHUFFLE(1, 0, 2, 1));
+        const __m128 Z23 = _mm_shuffle_ps(C, C, _MM_SHUFFLE(3, 0, 3, 0));
+        X = _mm_shuffle_ps(A, XY23, _MM_SHUFFLE(2, 0, 3, 0));
+        Y = _mm_shuffle_ps(YZ01, XY23, _MM_SHUFFLE(3, 1, 2, 0));
+        Z = _mm_shuffle_ps(YZ01, Z23, _MM_SHUFFLE(1, 0, 3, 1));
+    }
+
+    // Transposes in registers: the matrix elements of four objects are three
+    // 4x4 blocks.
+    SIMD_TARGET("sse2") SIMD_NO_CONTRACT inline void ComposeMatricesInterleavedSSE2(const float* Positions, const float* Rotations, const float* Scales,
+                                                                                    float* Matrices, std::size_t Count) {
+        std::size_t Index = 0;
+        for (; Index + 4 <= Count; Index += 4) {
+            __m128 X = _mm_loadu_ps(Rotations + Index * 4), Y = _mm_loadu_ps(Rotations + Index * 4 + 4);
+            __m128 Z = _mm_loadu_ps(Rotations + Index * 4 + 8), W = _mm_loadu_ps(Rotations + Index * 4 + 12);
+            _MM_TRANSPOSE4_PS(X, Y, Z, W);
+            __m128 SX, SY, SZ, Elements[12];
+            SplitTriplesSSE2(Scales + Index * 3, SX, SY, SZ);
+            ComposeBasisSSE2(X, Y, Z, W, SX, SY, SZ, Elements);
+            SplitTriplesSSE2(Positions + Index * 3, Elements[9], Elements[10], Elements[11]);
+            for (std::size_t Block = 0; Block < 12; Block += 4) {
+                _MM_TRANSPOSE4_PS(Elements[Block], Elements[Block + 1], Elements[Block + 2], Elements[Block + 3]);
+                for (std::size_t Object = 0; Object < 4; ++Object) {
+                    _mm_storeu_ps(Matrices + (Index + Object) * 12 + Block, Elements[Block + Object]);
+                }
+            }
+        }
+        ComposeMatricesInterleavedScalar(Positions, Rotations, Scales, Matrices, Count, Index);
+    }
+
+    // --- AVX2 ---
+    SIMD_TARGET("avx2,fma") SIMD_NO_CONTRACT inline void TranslateAVX2(TransformSpan Span, float DX, float DY, float DZ) {
+        const __m256 VX = _mm256_set1_ps(DX), VY = _mm256_set1_ps(DY), VZ = _mm256_set1_ps(DZ);
+        std::size_t Index = 0;
+        for (; Index + 8 <= Span.Count; Index += 8) {
+            _mm256_storeu_ps(Span.X + Index, _mm256_add_ps(_mm256_loadu_ps(Span.X + Index), VX));
+            _mm256_storeu_ps(Span.Y + Index, _mm256_add_ps(_mm256_loadu_ps(Span.Y + Index), VY));
+            _mm256_storeu_ps(Span.Z + Index, _mm256_add_ps(_mm256_loadu_ps(Span.Z + Index), VZ));
+        }
+        TranslateScalar(Span, DX, DY, DZ, Index);
+    }
+
+    SIMD_TARGET("avx2,fma") SIMD_NO_CONTRACT inline void ScaleAVX2(TransformSpan Span, float SX, float SY, float SZ) {
+        const __m256 VX = _mm256_set1_ps(SX), VY = _mm256_set1_ps(SY), VZ = _mm256_set1_ps(SZ);
+        std::size_t Index = 0;
+        for (; Index + 8 <= Span.Count; Index += 8) {
+            _mm256_storeu_ps(Span.X + Index, _mm256_mul_ps(_mm256_loadu_ps(Span.X + Index), VX));
+            _mm256_storeu_ps(Span.Y + Index, _mm256_mul_ps(_mm256_loadu_ps(Span.Y + Index), VY));
+            _mm256_storeu_ps(Span.Z + Index, _mm256_mul_ps(_mm256_loadu_ps(Span.Z + Index), VZ));
+        }
+        ScaleScalar(Span, SX, SY, SZ, Index);
+    }
+
+    SIMD_TARGET("avx2,fma") SIMD_NO_CONTRACT inline void DistanceAVX2(ConstTransformSpan Span, float PX, float PY, float PZ, float* Out) {
+        const __m256 VX = _mm256_set1_ps(PX), VY = _mm256_set1_ps(PY), VZ = _mm256_set1_ps(PZ);
+        std::size_t Index = 0;
+        for (; Index + 8 <= Span.Count; Index += 8) {
+            const __m256 DX = _mm256_sub_ps(_mm256_loadu_ps(Span.X + Index), VX);
+            const __m256 DY = _mm256_sub_ps(_mm256_loadu_ps(Span.Y + Index), VY);
+            const __m256 DZ = _mm256_sub_ps(_mm256_loadu_ps(Span.Z + Index), VZ);
+            const __m256 Squared = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(DX, DX), _mm256_mul_ps(DY, DY)), _mm256_mul_ps(DZ, DZ));
+            _mm256_storeu_ps(Out + Index, _mm256_sqrt_ps(Squared));
+        }
+        DistanceScalar(Span, PX, PY, PZ, Out, Index);
+    }
+
+    SIMD_TARGET("avx2,fma") SIMD_NO_CONTRACT inline __m128 HalvesMin(__m256 Value) {
+        return _mm_min_ps(_mm256_castps256_ps128(Value), _mm256_extractf128_ps(Value, 1));
+    }
+    SIMD_TARGET("avx2,fma") SIMD_NO_CONTRACT inline __m128 HalvesMax(__m256 Value) {
+        return _mm_max_ps(_mm256_castps256_ps128(Value), _mm256_extractf128_ps(Value, 1));
+    }
+
+    SIMD_TARGET("avx2,fma") SIMD_NO_CONTRACT inline TransformBounds BoundsAVX2(ConstTransformSpan Span) {
+        TransformBounds Bounds = EmptyBounds();
+        if (Span.Count < 8) return GrowBounds(Span, Bounds, 0), Bounds;
+        __m256 MinX = _mm256_loadu_ps(Span.X), MinY = _mm256_loadu_ps(Span.Y), MinZ = _mm256_loadu_ps(Span.Z);
+        __m256 MaxX = MinX, MaxY = MinY, MaxZ = MinZ;
+        std::size_t Index = 8;
+        for (; Index + 8 <= Span.Count; Index += 8) {
+            const __m256 X = _mm256_loadu_ps(Span.X + Index), Y = _mm256_loadu_ps(Span.Y + Index), Z = _mm256_loadu_ps(Span.Z + Index);
+            MinX = _mm256_min_ps(MinX, X); MaxX = _mm256_max_ps(MaxX, X);
+            MinY = _mm256_min_ps(MinY, Y); MaxY = _mm256_max_ps(MaxY, Y);
+            MinZ = _mm256_min_ps(MinZ, Z); MaxZ = _mm256_max_ps(MaxZ, Z);
+        }
+        Bounds = { { ReduceMinSSE2(HalvesMin(MinX)), ReduceMinSSE2(HalvesMin(MinY)), ReduceMinSSE2(HalvesMin(MinZ)) },
+                   { ReduceMaxSSE2(HalvesMax(MaxX)), ReduceMaxSSE2(HalvesMax(MaxY)), ReduceMaxSSE2(HalvesMax(MaxZ)) } };
+        GrowBounds(Span, Bounds, Index);
+        return Bounds;
+    }
+
+    SIMD_TARGET("avx2,fma") SIMD_NO_CONTRACT inline void TranslateInterleavedAVX2(float* XYZ, std::size_t Count, float DX, float DY, float DZ) {
+        const Pattern<8> Offsets(DX, DY, DZ);
+        const __m256 P0 = _mm256_load_ps(Offsets.Lanes), P1 = _mm256_load_ps(Offsets.Lanes + 8), P2 = _mm256_load_ps(Offsets.Lanes + 16);
+        std::size_t Index = 0;
+        for (; Index + 8 <= Count; Index += 8) {
+            float* At = XYZ + Index * 3;
+            _mm256_storeu_ps(At, _mm256_add_ps(_mm256_loadu_ps(At), P0));
+            _mm256_storeu_ps(At + 8, _mm256_add_ps(_mm256_loadu_ps(At + 8), P1));
+            _mm256_storeu_ps(At + 16, _mm256_add_ps(_mm256_loadu_ps(At + 16), P2));
+        }
+        TranslateInterleavedScalar(XYZ, Count, DX, DY, DZ, Index);
+    }
+
+    SIMD_TARGET("avx2,fma") SIMD_NO_CONTRACT inline void ScaleInterleavedAVX2(float* XYZ, std::size_t Count, float SX, float SY, float SZ) {
+        const Pattern<8> Factors(SX, SY, SZ);
+        const __m256 P0 = _mm256_load_ps(Factors.Lanes), P1 = _mm256_load_ps(Factors.Lanes + 8), P2 = _mm256_load_ps(Factors.Lanes + 16);
+        std::size_t Index = 0;
+        for (; Index + 8 <= Count; Index += 8) {
+            float* At = XYZ + Index * 3;
+            _mm256_storeu_ps(At, _mm256_mul_ps(_mm256_loadu_ps(At), P0));
+            _mm256_storeu_ps(At + 8, _mm256_mul_ps(_mm256_loadu_ps(At + 8), P1));
+            _mm256_storeu_ps(At + 16, _mm256_mul_ps(_mm256_loadu_ps(At + 16), P2));
+        }
+        ScaleInterleavedScalar(XYZ, Count, SX, SY, SZ, Index);
+    }
+
+    SIMD_TARGET("avx2") SIMD_NO_CONTRACT inline void ComposeMatricesAVX2(TrsColumns In, MatrixColumns Out, std::size_t Count) {
+        const __m256 One = _mm256_set1_ps(1.0f);
+        std::size_t Index = 0;
+        for (; Index + 8 <= Count; Index += 8) {
+            const __m256 X = _mm256_loadu_ps(In.Rotation[0] + Index), Y = _mm256_loadu_ps(In.Rotation[1] + Index);
+            const __m256 Z = _mm256_loadu_ps(In.Rotation[2] + Index), W = _mm256_loadu_ps(In.Rotation[3] + Index);
+            const __m256 X2 = _mm256_add_ps(X, X), Y2 = _mm256_add_ps(Y, Y), Z2 = _mm256_add_ps(Z, Z);
+            const __m256 XX = _mm256_mul_ps(X, X2), YY = _mm256_mul_ps(Y, Y2), ZZ = _mm256_mul_ps(Z, Z2);
+            const __m256 XY = _mm256_mul_ps(X, Y2), XZ = _mm256_mul_ps(X, Z2), YZ = _mm256_mul_ps(Y, Z2);
+            const __m256 WX = _mm256_mul_ps(W, X2), WY = _mm256_mul_ps(W, Y2), WZ = _mm256_mul_ps(W, Z2);
+            const __m256 SX = _mm256_loadu_ps(In.Scale[0] + Index), SY = _mm256_loadu_ps(In.Scale[1] + Index), SZ = _mm256_loadu_ps(In.Scale[2] + Index);
+            _mm256_storeu_ps(Out.Elements[0] + Index, _mm256_mul_ps(_mm256_sub_ps(One, _mm256_add_ps(YY, ZZ)), SX));
+            _mm256_storeu_ps(Out.Elements[1] + Index, _mm256_mul_ps(_mm256_add_ps(XY, WZ), SX));
+            _mm256_storeu_ps(Out.Elements[2] + Index, _mm256_mul_ps(_mm256_sub_ps(XZ, WY), SX));
+            _mm256_storeu_ps(Out.Elements[3] + Index, _mm256_mul_ps(_mm256_sub_ps(XY, WZ), SY));
+            _mm256_storeu_ps(Out.Elements[4] + Index, _mm256_mul_ps(_mm256_sub_ps(One, _mm256_add_ps(XX, ZZ)), SY));
+            _mm256_storeu_ps(Out.Elements[5] + Index, _mm256_mul_ps(_mm256_add_ps(YZ, WX), SY));
+            _mm256_storeu_ps(Out.Elements[6] + Index, _mm256_mul_ps(_mm256_add_ps(XZ, WY), SZ));
+            _mm256_storeu_ps(Out.Elements[7] + Index, _mm256_mul_ps(_mm256_sub_ps(YZ, WX), SZ));
+            _mm256_storeu_ps(Out.Elements[8] + Index, _mm256_mul_ps(_mm256_sub_ps(One, _mm256_add_ps(XX, YY)), SZ));
+            for (std::size_t Axis = 0; Axis < 3; ++Axis) {
+                _mm256_storeu_ps(Out.Elements[9 + Axis] + Index, _mm256_loadu_ps(In.Position[Axis] + Index));
+            }
+        }
+        ComposeMatricesScalar(In, Out, Count, Index);
+    }
+
+    // --- AVX-512 ---
+    // GCC 12 reports the deliberately undefined registers inside the AVX-512
+    // reduction intrinsics as maybe-uninitialized.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    SIMD_TARGET("avx512f") inline void TranslateAVX512(TransformSpan Span, float DX, float DY, float DZ) {
+        const __m512 VX = _mm512_set1_ps(DX), VY = _mm512_set1_ps(DY), VZ = _mm512_set1_ps(DZ);
+        std::size_t Index = 0;
+        for (; Index + 16 <= Span.Count; Index += 16) {
+            _mm512_storeu_ps(Span.X + Index, _mm512_add_ps(_mm512_loadu_ps(Span.X + Index), VX));
+            _mm512_storeu_ps(Span.Y + Index, _mm512_add_ps(_mm512_loadu_ps(Span.Y + Index), VY));
+            _mm512_storeu_ps(Span.Z + Index, _mm512_add_ps(_mm512_loadu_ps(Span.Z + Index), VZ));
+        }
+        TranslateScalar(Span, DX, DY, DZ, Index);
+    }
+
+    SIMD_TARGET("avx512f") inline void ScaleAVX512(TransformSpan Span, float SX, float SY, float SZ) {
+        const __m512 VX = _mm512_set1_ps(SX), VY = _mm512_set1_ps(SY), VZ = _mm512_set1_ps(SZ);
+        std::size_t Index = 0;
+        for (; Index + 16 <= Span.Count; Index += 16) {
+            _mm512_storeu_ps(Span.X + Index, _mm512_mul_ps(_mm512_loadu_ps(Span.X + Index), VX));
+            _mm512_storeu_ps(Span.Y + Index, _mm512_mul_ps(_mm512_loadu_ps(Span.Y + Index), VY));
+            _mm512_storeu_ps(Span.Z + Index, _mm512_mul_ps(_mm512_loadu_ps(Span.Z + Index), VZ));
+        }
+        ScaleScalar(Span, SX, SY, SZ, Index);
+    }
+
+    SIMD_TARGET("avx512f") SIMD_NO_CONTRACT inline void DistanceAVX512(ConstTransformSpan Span, float PX, float PY, float PZ, float* Out) {
+        const __m512 VX = _mm512_set1_ps(PX), VY = _mm512_set1_ps(PY), VZ = _mm512_set1_ps(PZ);
+        std::size_t Index = 0;
+        for (; Index + 16 <= Span.Count; Index += 16) {
+            const __m512 DX = _mm512_sub_ps(_mm512_loadu_ps(Span.X + Index), VX);
+            const __m512 DY = _mm512_sub_ps(_mm512_loadu_ps(Span.Y + Index), VY);
+            const __m512 DZ = _mm512_sub_ps(_mm512_loadu_ps(Span.Z + Index), VZ);
+            const __m512 Squared = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(DX, DX), _mm512_mul_ps(DY, DY)), _mm512_mul_ps(DZ, DZ));
+            _mm512_storeu_ps(Out + Index, _mm512_sqrt_ps(Squared));
+        }
+        DistanceScalar(Span, PX, PY, PZ, Out, Index);
+    }
+
+    SIMD_TARGET("avx512f") inline TransformBounds BoundsAVX512(ConstTransformSpan Span) {
+        TransformBounds Bounds = EmptyBounds();
+        if (Span.Count < 16) return GrowBounds(Span, Bounds, 0), Bounds;
+        __m512 MinX = _mm512_loadu_ps(Span.X), MinY = _mm512_loadu_ps(Span.Y), MinZ = _mm512_loadu_ps(Span.Z);
+        __m512 MaxX = MinX, MaxY = MinY, MaxZ = MinZ;
+        std::size_t Index = 16;
+        for (; Index + 16 <= Span.Count; Index += 16) {
+            const __m512 X = _mm512_loadu_ps(Span.X + Index), Y = _mm512_loadu_ps(Span.Y + Index), Z = _mm512_loadu_ps(Span.Z + Index);
+            MinX = _mm512_min_ps(MinX, X); MaxX = _mm512_max_ps(MaxX, X);
+            MinY = _mm512_min_ps(MinY, Y); MaxY = _mm512_max_ps(MaxY, Y);
+            MinZ = _mm512_min_ps(MinZ, Z); MaxZ = _mm512_max_ps(MaxZ, Z);
+        }
+        Bounds = { { _mm512_reduce_min_ps(MinX), _mm512_reduce_min_ps(MinY), _mm512_reduce_min_ps(MinZ) },
+                   { _mm512_reduce_max_ps(MaxX), _mm512_reduce_max_ps(MaxY), _mm512_reduce_max_ps(MaxZ) } };
+        GrowBounds(Span, Bounds, Index);
+        return Bounds;
+    }
+
+    SIMD_TARGET("avx512f") inline void TranslateInterleavedAVX512(float* XYZ, std::size_t Count, float DX, float DY, float DZ) {
+        const Pattern<16> Offsets(DX, DY, DZ);
+        const __m512 P0 = _mm512_load_ps(Offsets.Lanes), P1 = _mm512_load_ps(Offsets.Lanes + 16), P2 = _mm512_load_ps(Offsets.Lanes + 32);
+        std::size_t Index = 0;
+        for (; Index + 16 <= Count; Index += 16) {
+            float* At = XYZ + Index * 3;
+            _mm512_storeu_ps(At, _mm512_add_ps(_mm512_loadu_ps(At), P0));
+            _mm512_storeu_ps(At + 16, _mm512_add_ps(_mm512_loadu_ps(At + 16), P1));
+            _mm512_storeu_ps(At + 32, _mm512_add_ps(_mm512_loadu_ps(At + 32), P2));
+        }
+        TranslateInterleavedScalar(XYZ, Count, DX, DY, DZ, Index);
+    }
+
+    SIMD_TARGET("avx512f") inline void ScaleInterleavedAVX512(float* XYZ, std::size_t Count, float SX, float SY, float SZ) {
+        const Pattern<16> Factors(SX, SY, SZ);
+        const __m512 P0 = _mm512_load_ps(Factors.Lanes), P1 = _mm512_load_ps(Factors.Lanes + 16), P2 = _mm512_load_ps(Factors.Lanes + 32);
+        std::size_t Index = 0;
+        for (; Index + 16 <= Count; Index += 16) {
+            float* At = XYZ + Index * 3;
+            _mm512_storeu_ps(At, _mm512_mul_ps(_mm512_loadu_ps(At), P0));
+            _mm512_storeu_ps(At + 16, _mm512_mul_ps(_mm512_loadu_ps(At + 16), P1));
+            _mm512_storeu_ps(At + 32, _mm512_mul_ps(_mm512_loadu_ps(At + 32), P2));
+        }
+        ScaleInterleavedScalar(XYZ, Count, SX, SY, SZ, Index);
+    }
+
+    SIMD_TARGET("avx512f") SIMD_NO_CONTRACT inline void ComposeMatricesAVX512(TrsColumns In, MatrixColumns Out, std::size_t Count) {
+        const __m512 One = _mm512_set1_ps(1.0f);
+        std::size_t Index = 0;
+        for (; Index + 16 <= Count; Index += 16) {
+            const __m512 X = _mm512_loadu_ps(In.Rotation[0] + Index), Y = _mm512_loadu_ps(In.Rotation[1] + Index);
+            const __m512 Z = _mm512_loadu_ps(In.Rotation[2] + Index), W = _mm512_loadu_ps(In.Rotation[3] + Index);
+            const __m512 X2 = _mm512_add_ps(X, X), Y2 = _mm512_add_ps(Y, Y), Z2 = _mm512_add_ps(Z, Z);
+            const __m512 XX = _mm512_mul_ps(X, X2), YY = _mm512_mul_ps(Y, Y2), ZZ = _mm512_mul_ps(Z, Z2);
+            const __m512 XY = _mm512_mul_ps(X, Y2), XZ = _mm512_mul_ps(X, Z2), YZ = _mm512_mul_ps(Y, Z2);
+            const __m512 WX = _mm512_mul_ps(W, X2), WY = _mm512_mul_ps(W, Y2), WZ = _mm512_mul_ps(W, Z2);
+            const __m512 SX = _mm512_loadu_ps(In.Scale[0] + Index), SY = _mm512_loadu_ps(In.Scale[1] + Index), SZ = _mm512_loadu_ps(In.Scale[2] + Index);
+            _mm512_storeu_ps(Out.Elements[0] + Index, _mm512_mul_ps(_mm512_sub_ps(One, _mm512_add_ps(YY, ZZ)), SX));
+            _mm512_storeu_ps(Out.Elements[1] + Index, _mm512_mul_ps(_mm512_add_ps(XY, WZ), SX));
+            _mm512_storeu_ps(Out.Elements[2] + Index, _mm512_mul_ps(_mm512_sub_ps(XZ, WY), SX));
+            _mm512_storeu_ps(Out.Elements[3] + Index, _mm512_mul_ps(_mm512_sub_ps(XY, WZ), SY));
+            _mm512_storeu_ps(Out.Elements[4] + Index, _mm512_mul_ps(_mm512_sub_ps(One, _mm512_add_ps(XX, ZZ)), SY));
+            _mm512_storeu_ps(Out.Elements[5] + Index, _mm512_mul_ps(_mm512_add_ps(YZ, WX), SY));
+            _mm512_storeu_ps(Out.Elements[6] + Index, _mm512_mul_ps(_mm512_add_ps(XZ, WY), SZ));
+            _mm512_storeu_ps(Out.Elements[7] + Index, _mm512_mul_ps(_mm512_sub_ps(YZ, WX), SZ));
+            _mm512_storeu_ps(Out.Elements[8] + Index, _mm512_mul_ps(_mm512_sub_ps(One, _mm512_add_ps(XX, YY)), SZ));
+            for (std::size_t Axis = 0; Axis < 3; ++Axis) {
+                _mm512_storeu_ps(Out.Elements[9 + Axis] + Index, _mm512_loadu_ps(In.Position[Axis] + Index));
+            }
+        }
+        ComposeMatricesScalar(In, Out, Count, Index);
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif // SIMD_TRANSFORM_X86
+
+    inline void TranslateDefault(TransformSpan Span, float DX, float DY, float DZ) { TranslateScalar(Span, DX, DY, DZ); }
+    inline void ScaleDefault(TransformSpan Span, float SX, float SY, float SZ) { ScaleScalar(Span, SX, SY, SZ); }
+    inline void DistanceDefault(ConstTransformSpan Span, float PX, float PY, float PZ, float* Out) { DistanceScalar(Span, PX, PY, PZ, Out); }
+    inline void TranslateInterleavedDefault(float* XYZ, std::size_t Count, float DX, float DY, float DZ) { TranslateInterleavedScalar(XYZ, Count, DX, DY, DZ); }
+    inline void ScaleInterleavedDefault(float* XYZ, std::size_t Count, float SX, float SY, float SZ) { ScaleInterleavedScalar(XYZ, Count, SX, SY, SZ); }
+    inline void ComposeMatricesDefault(TrsColumns In, MatrixColumns Out, std::size_t Count) { ComposeMatricesScalar(In, Out, Count); }
+    inline void ComposeMatricesInterleavedDefault(const float* Positions, const float* Rotations, const float* Scales, float* Matrices, std::size_t Count) {
+        ComposeMatricesInterleavedScalar(Positions, Rotations, Scales, Matrices, Count);
+    }
+} // namespace SimdTransformDetail
+
+// The widest instruction set both the CPU and the operating system support.
+inline SimdLevel DetectSimdLevel() {
+#ifdef SIMD_TRANSFORM_X86
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#else
+    int Registers[4];
+    __cpuid(Registers, 0);
+    const int Highest = Registers[0];
+    __cpuid(Registers, 1);
+    const bool Sse2 = (Registers[3] >> 26) & 1, Fma = (Registers[2] >> 12) & 1, OsSaves = (Registers[2] >> 27) & 1;
+    const unsigned long long Enabled = OsSaves ? _xgetbv(0) : 0;
+    if (Highest >= 7) {
+        __cpuidex(Registers, 7, 0);
+        if (((Registers[1] >> 16) & 1) && (Enabled & 0xE6) == 0xE6) return SimdLevel::AVX512;
+        if (((Registers[1] >> 5) & 1) && Fma && (Enabled & 0x6) == 0x6) return SimdLevel::AVX2;
+    }
+    if (Sse2) return SimdLevel::SSE2;
+#endif
+#endif
+    return SimdLevel::Scalar;
+}
+
+// The kernels for Level, or the scalar ones if this build has no such set.
+// Calling kernels above DetectSimdLevel() faults on CPUs without them.
+inline const TransformKernelTable& KernelsFor(SimdLevel Level) {
+    using namespace SimdTransformDetail;
+    static const TransformKernelTable Scalar{ SimdLevel::Scalar, &TranslateDefault, &ScaleDefault, &DistanceDefault, &BoundsScalar,
+                                              &TranslateInterleavedDefault, &ScaleInterleavedDefault, &ComposeMatricesDefault,
+                                              &ComposeMatricesInterleavedDefault };
+#ifdef SIMD_TRANSFORM_X86
+    static const TransformKernelTable Sse2{ SimdLevel::SSE2, &TranslateSSE2, &ScaleSSE2, &DistanceSSE2, &BoundsSSE2,
+                                            &TranslateInterleavedSSE2, &ScaleInterleavedSSE2, &ComposeMatricesSSE2,
+                                            &ComposeMatricesInterleavedSSE2 };
+    static const TransformKernelTable Avx2{ SimdLevel::AVX2, &TranslateAVX2, &ScaleAVX2, &DistanceAVX2, &BoundsAVX2,
+                                            &TranslateInterleavedAVX2, &ScaleInterleavedAVX2, &ComposeMatricesAVX2,
+                                            &ComposeMatricesInterleavedSSE2 };
+    static const TransformKernelTable Avx512{ SimdLevel::AVX512, &TranslateAVX512, &ScaleAVX512, &DistanceAVX512, &BoundsAVX512,
+                                              &TranslateInterleavedAVX512, &ScaleInterleavedAVX512, &ComposeMatricesAVX512,
+                                              &ComposeMatricesInterleavedSSE2 };
+    switch (Level) {
+        case SimdLevel::SSE2: return Sse2;
+        case SimdLevel::AVX2: return Avx2;
+        case SimdLevel::AVX512: return Avx512;
+        default: break;
+    }
+#endif
+    (void)Level;
+    return Scalar;
+}
+
+// The best kernels for this CPU, chosen on first use.
+inline const TransformKernelTable& TransformKernels() {
+    static const TransformKernelTable& Best = KernelsFor(DetectSimdLevel());
+    return Best;
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef SIMD_TRANSFORM_ENABLE_EXAMPLES
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t Count = 16387; // Fits in L2, and leaves a tail for every width.
+    constexpr int Repeats = 2000;
+
+    std::mt19937 Random(3);
+    std::uniform_real_distribution<float> Coordinate(-500.0f, 500.0f);
+    std::vector<float> SourceX(Count), SourceY(Count), SourceZ(Count), SourceXYZ(Count * 3);
+    for (std::size_t Index = 0; Index < Count; ++Index) {
+        SourceX[Index] = SourceXYZ[Index * 3] = Coordinate(Random);
+        SourceY[Index] = SourceXYZ[Index * 3 + 1] = Coordinate(Random);
+        SourceZ[Index] = SourceXYZ[Index * 3 + 2] = Coordinate(Random);
+    }
+
+    const SimdLevel Best = DetectSimdLevel();
+    std::printf("CPU supports up to %s; dispatch picks %s\n", SimdLevelName(Best), SimdLevelName(TransformKernels().Level));
+    std::printf("%-8s %12s %12s %12s %12s %12s  (ns per 1000 positions)\n", "", "translate", "scale", "distance", "bounds", "interleaved");
+
+    const TransformBounds Reference = KernelsFor(SimdLevel::Scalar).Bounds(ConstTransformSpan(SourceX.data(), SourceY.data(), SourceZ.data(), Count));
+    std::vector<float> ReferenceDistances(Count);
+    KernelsFor(SimdLevel::Scalar).Distance(ConstTransformSpan(SourceX.data(), SourceY.data(), SourceZ.data(), Count), 10.0f, 0.0f, -5.0f, ReferenceDistances.data());
+
+    // Matrices from the positions, random unit rotations and random scales.
+    std::uniform_real_distribution<float> Unit(-1.0f, 1.0f), Size(0.5f, 2.0f);
+    std::vector<float> Rotations[4], Scales(Count);
+    for (std::vector<float>& Component : Rotations) Component.resize(Count);
+    for (std::size_t Index = 0; Index < Count; ++Index) {
+        float Quaternion[4] = { Unit(Random), Unit(Random), Unit(Random), Unit(Random) };
+        const float Length = std::sqrt(Quaternion[0] * Quaternion[0] + Quaternion[1] * Quaternion[1] + Quaternion[2] * Quaternion[2] + Quaternion[3] * Quaternion[3]);
+        for (std::size_t Component = 0; Component < 4; ++Component) Rotations[Component][Index] = Quaternion[Component] / Length;
+        Scales[Index] = Size(Random);
+    }
+    const TrsColumns Trs{ { SourceX.data(), SourceY.data(), SourceZ.data() },
+                          { Rotations[0].data(), Rotations[1].data(), Rotations[2].data(), Rotations[3].data() },
+                          { Scales.data(), Scales.data(), Scales.data() } };
+    const auto Compose = [&](const TransformKernelTable& Kernels) {
+        std::vector<float> Matrices(Count * 12);
+        MatrixColumns Out;
+        for (std::size_t Element = 0; Element < 12; ++Element) Out.Elements[Element] = Matrices.data() + Element * Count;
+        Kernels.ComposeMatrices(Trs, Out, Count);
+        return Matrices;
+    };
+    const std::vector<float> ReferenceMatrices = Compose(KernelsFor(SimdLevel::Scalar));
+    for (const SimdLevel Level : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 }) {
+        if (Level > Best) {
+            std::printf("%-8s not supported by this CPU\n", SimdLevelName(Level));
+            continue;
+        }
+        const TransformKernelTable& Kernels = KernelsFor(Level);
+        std::vector<float> X = SourceX, Y = SourceY, Z = SourceZ, XYZ = SourceXYZ, Distances(Count);
+        const TransformSpan Span{ X.data(), Y.data(), Z.data(), Count };
+        const auto Time = [&](auto&& Run) {
+            const auto Start = Clock::now();
+            for (int Repeat = 0; Repeat < Repeats; ++Repeat) Run();
+            return std::chrono::duration<double, std::nano>(Clock::now() - Start).count() / Repeats / (Count / 1000.0);
+        };
+        TransformBounds Bounds{};
+        const double Translate = Time([&] { Kernels.Translate(Span, 0.5f, -0.25f, 1.0f); });
+        const double Scale = Time([&] { Kernels.Scale(Span, 1.0001f, 0.9999f, 1.0f); });
+        const double Distance = Time([&] { Kernels.Distance(Span, 10.0f, 0.0f, -5.0f, Distances.data()); });
+        const double BoundsTime = Time([&] { Bounds = Kernels.Bounds(ConstTransformSpan(SourceX.data(), SourceY.data(), SourceZ.data(), Count)); });
+        const double Interleaved = Time([&] { Kernels.TranslateInterleaved(XYZ.data(), Count, 0.5f, -0.25f, 1.0f); });
+        const bool Agrees = std::equal(std::begin(Bounds.Min), std::end(Bounds.Min), std::begin(Reference.Min))
+                         && std::equal(std::begin(Bounds.Max), std::end(Bounds.Max), std::begin(Reference.Max));
+        Kernels.Distance(ConstTransformSpan(SourceX.data(), SourceY.data(), SourceZ.data(), Count), 10.0f, 0.0f, -5.0f, Distances.data());
+        const bool DistancesAgree = std::memcmp(Distances.data(), ReferenceDistances.data(), Count * sizeof(float)) == 0;
+        const bool MatricesAgree = std::memcmp(Compose(Kernels).data(), ReferenceMatrices.data(), ReferenceMatrices.size() * sizeof(float)) == 0;
+        std::printf("%-8s %12.1f %12.1f %12.1f %12.1f %12.1f  bounds %s, distances %s, matrices %s\n", SimdLevelName(Level), Translate, Scale, Distance,
+                    BoundsTime, Interleaved, Agrees ? "match" : "DIFFER", DistancesAgree ? "match" : "DIFFER", MatricesAgree ? "match" : "DIFFER");
+    }
+    return 0;
+}
+
+#endif // SIMD_TRANSFORM_ENABLE_EXAMPLES
+
+#endif // SIMD_TRANSFORM_KERNELS_CPP
@@ -0,0 +1,487 @@
+#ifndef STATE_REPLICATION_CPP
+#define STATE_REPLICATION_CPP
+
+#include "attribute-serialization.cpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+// --- Tier 6: State Replication with Interest Management ---
+// A server-side StateReplicator turns changes in a CompositionPool into
+// packets for a set of observers. Each observer sees only instances within
+// its relevance radius of its view position (read from the Composition's
+// position Attribute). Relevant instances with columns stamped since they were
+// last sent to that observer accumulate priority every tick, more so when
+// close; each tick the highest priorities are written until the observer's
+// byte budget is spent. Unsent instances keep their priority, so distant
+// objects are delayed rather than starved.
+//
+// Dirtiness is tracked per (chunk, column) stamp, so a record may carry an
+// Attribute whose own value did not change. Instances that leave relevance or
+// are despawned produce remove records, which are always sent.
+//
+// Tick() sends what was stamped up to the pool's current version: run it after
+// the frame's simulation and before AdvanceVersion(). Delivery is assumed, as
+// on the in-process and loopback transports; lost packets are not re-sent.
+//
+// No packet exceeds MaxPacketSize. An update too large for one packet is
+// split into one record per Attribute. An Attribute that alone does not fit
+// (a long string, say) is not sent and stays dirty. OversizedAttributes()
+// counts it once, however many ticks and observers skip it, and again only
+// if it fits for a while and then outgrows a packet anew.
+//
+// Replicated Compositions carry a ReplicationId Attribute, since pool indices
+// move when instances are despawned.
+
+struct ReplicationId : public Attribute {
+    std::uint32_t Value = 0;
+};
+
+namespace ReplicationDetail {
+    inline constexpr std::size_t MaxPacketSize = 1200;
+
+    enum class RecordKind : std::uint8_t { Update, Remove };
+
+    // Whether a byte read from a packet names a RecordKind.
+    constexpr bool IsRecordKind(std::uint8_t Value) { return Value <= static_cast<std::uint8_t>(RecordKind::Remove); }
+} // namespace ReplicationDetail
+
+template <typename TPool, typename TPositionAttribute>
+class StateReplicator {
+public:
+    static constexpr std::size_t IdColumn = TPool::template ColumnIndex<ReplicationId>;
+    static_assert(IdColumn < TPool::AttributeCount, "Replication Error: Replicated Compositions need a ReplicationId Attribute.");
+    static_assert(TPool::template ColumnIndex<TPositionAttribute> < TPool::AttributeCount,
+        "Replication Error: The position Attribute is not part of the Composition.");
+    static_assert(TPool::AttributeCount <= 32, "Replication Error: Attribute masks are 32 bits wide.");
+
+    struct ObserverView {
+        float X = 0.0f, Y = 0.0f, Z = 0.0f;
+        float RelevanceRadius = 100.0f;
+        std::size_t BytesPerTick = 4096;
+    };
+
+    explicit StateReplicator(const TPool& InPool) : Pool(InPool) {}
+
+    std::uint32_t AddObserver(const ObserverView& View) {
+        Observers.emplace_back().View = View;
+        return static_cast<std::uint32_t>(Observers.size() - 1);
+    }
+
+    void SetView(std::uint32_t Observer, const ObserverView& View) { Observers[Observer].View = View; }
+
+    // Attribute values skipped because they alone exceed a packet, each
+    // counted once.
+    std::size_t OversizedAttributes() const { return OversizedAttributeCount; }
+
+    // Sends this tick's packets to every observer; returns the bytes sent.
+    template <typename TTransport>
+    std::size_t Tick(TTransport& Transport) {
+        std::size_t Sent = 0;
+        for (std::uint32_t Observer = 0; Observer < Observers.size(); ++Observer) {
+            Sent += TickObserver(Observer, Transport);
+        }
+        return Sent;
+    }
+
+private:
+    struct ReplicaState {
+        float Priority = 0.0f;
+        std::uint64_t SeenTick = 0;
+        std::array<std::uint64_t, TPool::AttributeCount> SentVersions{};
+    };
+
+    struct Candidate {
+        std::uint32_t Index;
+        std::uint32_t Mask;
+        ReplicaState* State;
+        std::uint32_t Id;
+    };
+
+    struct ObserverState {
+        ObserverView View;
+        std::unordered_map<std::uint32_t, ReplicaState> Replicas;
+        std::uint64_t Ticks = 0;
+    };
+
+    template <typename TTransport>
+    std::size_t TickObserver(std::uint32_t ObserverIndex, TTransport& Transport) {
+        using namespace ReplicationDetail;
+        ObserverState& Observer = Observers[ObserverIndex];
+        const ObserverView& View = Observer.View;
+        const float RadiusSquared = View.RelevanceRadius * View.RelevanceRadius;
+        const std::uint64_t Tick = ++Observer.Ticks;
+
+        // Gather relevant instances with unsent changes and raise their priority.
+        Candidates.clear();
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Pool.ChunkCount(); ++ChunkIndex) {
+            const ReplicationId* Ids = Pool.template Column<ReplicationId>(ChunkIndex);
+            const TPositionAttribute* Positions = Pool.template Column<TPositionAttribute>(ChunkIndex);
+            for (std::uint32_t Slot = 0; Slot < Pool.ChunkSize(ChunkIndex); ++Slot) {
+                const float DX = Positions[Slot].X - View.X, DY = Positions[Slot].Y - View.Y, DZ = Positions[Slot].Z - View.Z;
+                const float DistanceSquared = DX * DX + DY * DY + DZ * DZ;
+                if (DistanceSquared > RadiusSquared) continue;
+
+                ReplicaState& State = Observer.Replicas[Ids[Slot].Value];
+                State.SeenTick = Tick;
+                std::uint32_t Mask = 0;
+                for (std::size_t Column = 0; Column < TPool::AttributeCount; ++Column) {
+                    if (Pool.ColumnVersion(ChunkIndex, Column) > State.SentVersions[Column]) Mask |= 1u << Column;
+                }
+                if (Mask == 0) continue;
+                State.Priority += 1.0f + 4.0f * (1.0f - DistanceSquared / RadiusSquared);
+                Candidates.push_back({ static_cast<std::uint32_t>(ChunkIndex * TPool::Capacity + Slot), Mask, &State, Ids[Slot].Value });
+            }
+        }
+        std::sort(Candidates.begin(), Candidates.end(),
+            [](const Candidate& A, const Candidate& B) { return A.State->Priority > B.State->Priority; });
+
+        std::size_t Sent = 0;
+        std::uint16_t Records = 0;
+        Packet.assign(sizeof(Records), std::byte{});
+        const auto Flush = [&] {
+            if (Records == 0) return;
+            std::memcpy(Packet.data(), &Records, sizeof(Records));
+            Transport.Send(ObserverIndex, std::span<const std::byte>(Packet));
+            Sent += Packet.size();
+            Records = 0;
+            Packet.assign(sizeof(Records), std::byte{});
+        };
+        const auto Emit = [&] {
+            if (Packet.size() + Record.size() > MaxPacketSize) Flush();
+            Packet.insert(Packet.end(), Record.begin(), Record.end());
+            ++Records;
+        };
+
+        // Instances not seen this tick left relevance or no longer exist.
+        for (auto Replica = Observer.Replicas.begin(); Replica != Observer.Replicas.end();) {
+            if (Replica->second.SeenTick == Tick) { ++Replica; continue; }
+            Record.clear();
+            SerializationDetail::AppendBytes(Record, &Replica->first, sizeof(std::uint32_t));
+            const RecordKind Kind = RecordKind::Remove;
+            SerializationDetail::AppendBytes(Record, &Kind, sizeof(Kind));
+            Emit();
+            Replica = Observer.Replicas.erase(Replica);
+        }
+
+        // Sends the columns in Mask as one update record, unless the record
+        // would not fit in a packet or the observer's budget is spent.
+        enum class Outcome { Sent, TooLarge, OverBudget };
+        const auto EmitUpdate = [&](const Candidate& Next, std::uint32_t Mask) {
+            Record.clear();
+            SerializationDetail::AppendBytes(Record, &Next.Id, sizeof(Next.Id));
+            const RecordKind Kind = RecordKind::Update;
+            SerializationDetail::AppendBytes(Record, &Kind, sizeof(Kind));
+            SerializationDetail::AppendBytes(Record, &Mask, sizeof(Mask));
+            WriteMasked(Next.Index, Mask, std::make_index_sequence<TPool::AttributeCount>{});
+            if (sizeof(Records) + Record.size() > MaxPacketSize) return Outcome::TooLarge;
+            if (Sent + Packet.size() + Record.size() > View.BytesPerTick) return Outcome::OverBudget;
+            Emit();
+            if (!Oversized.empty()) ClearOversized(Next.Id, Mask);
+            Next.State->Priority = 0.0f;
+            for (std::size_t Column = 0; Column < TPool::AttributeCount; ++Column) {
+                if (Mask & (1u << Column)) Next.State->SentVersions[Column] = Pool.Version();
+            }
+            return Outcome::Sent;
+        };
+
+        for (const Candidate& Next : Candidates) {
+            Outcome Result = EmitUpdate(Next, Next.Mask);
+            for (std::size_t Column = 0; Result == Outcome::TooLarge && Column < TPool::AttributeCount; ++Column) {
+                if (!(Next.Mask & (1u << Column))) continue;
+                const Outcome Split = EmitUpdate(Next, 1u << Column);
+                if (Split == Outcome::TooLarge) CountOversized(Next.Id, 1u << Column);
+                if (Split == Outcome::OverBudget) Result = Outcome::OverBudget;
+            }
+            if (Result == Outcome::OverBudget) break;
+        }
+        Flush();
+        return Sent;
+    }
+
+    // Oversized tracks, by ReplicationId, the columns already counted, until
+    // they are sent.
+    void CountOversized(std::uint32_t Id, std::uint32_t Column) {
+        std::uint32_t& Counted = Oversized[Id];
+        if (Counted & Column) return;
+        Counted |= Column;
+        ++OversizedAttributeCount;
+    }
+
+    void ClearOversized(std::uint32_t Id, std::uint32_t Mask) {
+        const auto Found = Oversized.find(Id);
+        if (Found == Oversized.end()) return;
+        Found->second &= ~Mask;
+        if (Found->second == 0) Oversized.erase(Found);
+    }
+
+    template <std::size_t... I>
+    void WriteMasked(std::uint32_t Index, std::uint32_t Mask, std::index_sequence<I...>) {
+        ((Mask & (1u << I) ? SerializationDetail::WriteFields(Record, Pool.template Attribute<typename TPool::template AttributeAt<I>>(Index))
+                           : void()), ...);
+    }
+
+    const TPool& Pool;
+    std::vector<ObserverState> Observers;
+    std::vector<Candidate> Candidates;
+    std::vector<std::byte> Packet;
+    std::vector<std::byte> Record;
+    std::unordered_map<std::uint32_t, std::uint32_t> Oversized;
+    std::size_t OversizedAttributeCount = 0;
+};
+
+// The client side: applies packets to a local pool, spawning instances the
+// first time their ReplicationId is seen. Spawn hooks run after the first
+// update's fields are read, so they see the replicated values.
+template <typename TPool>
+class ReplicaReceiver {
+public:
+    explicit ReplicaReceiver(TPool& InPool) : Pool(InPool) {}
+
+    bool Apply(std::span<const std::byte> Packet) {
+        using namespace ReplicationDetail;
+        SerializationDetail::ByteReader Reader(Packet);
+        std::uint16_t Records = 0;
+        if (!Reader.Read(Records)) return false;
+        for (std::uint16_t Record = 0; Record < Records; ++Record) {
+            std::uint32_t Id = 0;
+            std::uint8_t KindByte = 0;
+            if (!Reader.Read(Id) || !Reader.Read(KindByte) || !IsRecordKind(KindByte)) return false;
+            if (static_cast<RecordKind>(KindByte) == RecordKind::Remove) {
+                Remove(Id);
+                continue;
+            }
+            std::uint32_t Mask = 0;
+            if (!Reader.Read(Mask)) return false;
+            auto [Found, Inserted] = IndexOf.try_emplace(Id, 0);
+            if (Inserted) {
+                Found->second = Pool.AllocateDefault(1);
+                Pool.template Attribute<ReplicationId>(Found->second).Value = Id;
+            }
+            const bool Read = ReadMasked(Reader, Found->second, Mask, std::make_index_sequence<TPool::AttributeCount>{});
+            if (Inserted) {
+                Pool.RunSpawnHooks(Found->second, 1);
+                // A truncated first update leaves no half-read replica behind.
+                if (!Read) Remove(Id);
+            }
+            if (!Read) return false;
+        }
+        return true;
+    }
+
+    std::size_t Size() const { return Pool.Size(); }
+
+private:
+    void Remove(std::uint32_t Id) {
+        const auto Found = IndexOf.find(Id);
+        if (Found == IndexOf.end()) return;
+        const std::size_t Index = Found->second, Last = Pool.Size() - 1;
+        const std::uint32_t LastId = Pool.template Attribute<ReplicationId>(Last).Value;
+        Pool.Despawn(Index);
+        IndexOf.erase(Found);
+        if (Index != Last) IndexOf[LastId] = Index;
+    }
+
+    template <std::size_t... I>
+    bool ReadMasked(SerializationDetail::ByteReader& Reader, std::size_t Index, std::uint32_t Mask, std::index_sequence<I...>) {
+        return ((!(Mask & (1u << I))
+            || SerializationDetail::ReadFields(Reader, Pool.template Attribute<typename TPool::template AttributeAt<I>>(Index))) && ...);
+    }
+
+    TPool& Pool;
+    std::unordered_map<std::uint32_t, std::size_t> IndexOf;
+};
+
+// --- Transports ---
+// Both deliver whole packets per observer: Send(Observer, Bytes) and
+// Receive(Observer, Out), which returns false when nothing is waiting.
+class InProcessTransport {
+public:
+    explicit InProcessTransport(std::size_t ObserverCount) : Queues(ObserverCount) {}
+
+    void Send(std::uint32_t Observer, std::span<const std::byte> Packet) {
+        Queues[Observer].emplace_back(Packet.begin(), Packet.end());
+    }
+
+    bool Receive(std::uint32_t Observer, std::vector<std::byte>& Packet) {
+        if (Queues[Observer].empty()) return false;
+        Packet = std::move(Queues[Observer].front());
+        Queues[Observer].pop_front();
+        return true;
+    }
+
+private:
+    std::vector<std::deque<std::vector<std::byte>>> Queues;
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+// One non-blocking UDP socket per observer on 127.0.0.1, plus a sending socket.
+class UdpLoopbackTransport {
+public:
+    explicit UdpLoopbackTransport(std::size_t ObserverCount) {
+        Sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+        for (std::size_t Observer = 0; Observer < ObserverCount; ++Observer) {
+            const int Socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+            sockaddr_in Address{};
+            Address.sin_family = AF_INET;
+            Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            socklen_t Length = sizeof(Address);
+            const int Buffer = 1 << 22;
+            ::setsockopt(Socket, SOL_SOCKET, SO_RCVBUF, &Buffer, sizeof(Buffer));
+            ::bind(Socket, reinterpret_cast<sockaddr*>(&Address), sizeof(Address));
+            ::getsockname(Socket, reinterpret_cast<sockaddr*>(&Address), &Length);
+            ::fcntl(Socket, F_SETFL, ::fcntl(Socket, F_GETFL) | O_NONBLOCK);
+            Receivers.push_back(Socket);
+            Addresses.push_back(Address);
+        }
+    }
+
+    ~UdpLoopbackTransport() {
+        for (const int Socket : Receivers) ::close(Socket);
+        if (Sender >= 0) ::close(Sender);
+    }
+
+    UdpLoopbackTransport(const UdpLoopbackTransport&) = delete;
+    UdpLoopbackTransport& operator=(const UdpLoopbackTransport&) = delete;
+
+    bool Ok() const { return Sender >= 0 && std::all_of(Receivers.begin(), Receivers.end(), [](int Socket) { return Socket >= 0; }); }
+
+    void Send(std::uint32_t Observer, std::span<const std::byte> Packet) {
+        ::sendto(Sender, Packet.data(), Packet.size(), 0, reinterpret_cast<const sockaddr*>(&Addresses[Observer]), sizeof(sockaddr_in));
+    }
+
+    // Datagrams longer than MaxPacketSize arrive cut short; they are dropped
+    // and counted in Truncated() instead of being handed on.
+    bool Receive(std::uint32_t Observer, std::vector<std::byte>& Packet) {
+        for (;;) {
+            Packet.resize(ReplicationDetail::MaxPacketSize);
+            iovec Buffer{ Packet.data(), Packet.size() };
+            msghdr Message{};
+            Message.msg_iov = &Buffer;
+            Message.msg_iovlen = 1;
+            const ssize_t Received = ::recvmsg(Receivers[Observer], &Message, 0);
+            if (Received <= 0) return false;
+            if (Message.msg_flags & MSG_TRUNC) {
+                ++TruncatedCount;
+                continue;
+            }
+            Packet.resize(static_cast<std::size_t>(Received));
+            return true;
+        }
+    }
+
+    std::size_t Truncated() const { return TruncatedCount; }
+
+private:
+    int Sender = -1;
+    std::vector<int> Receivers;
+    std::vector<sockaddr_in> Addresses;
+    std::size_t TruncatedCount = 0;
+};
+#endif
+
+
+// --- EXAMPLE USAGE ---
+#ifdef REPLICATION_ENABLE_EXAMPLES
+
+#include <cmath>
+
+struct Transform : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Category : public Attribute {
+    std::string Name = "Default";
+};
+
+std::size_t DefaultOnCreate = 0;
+
+class Registrar : public Role {
+public:
+    template <typename THost>
+    void OnCreate(THost& Host) { DefaultOnCreate += Host.template Attribute<Category>().Name == "Default"; }
+};
+
+class Unit : public Composition<Unit, TypeList<Registrar>, TypeList<ReplicationId, Transform, Category>> {};
+
+using UnitPool = CompositionPool<Unit>;
+
+template <typename TTransport>
+void RunSession(const char* Label, TTransport& Transport) {
+    UnitPool Server;
+    for (std::uint32_t Index = 0; Index < 20000; ++Index) {
+        Server.Spawn(ReplicationId{{}, Index}, Transform{{}, float(Index % 200) * 5.0f, float(Index / 200) * 5.0f, 0.0f}, Category{{}, "Unit"});
+    }
+    // A name too long for any packet: the unit still replicates, its name never does.
+    Server.Spawn(ReplicationId{{}, 20000}, Transform{{}, 100.0f, 100.0f, 0.0f}, Category{{}, std::string(2000, 'x')});
+
+    DefaultOnCreate = 0;
+
+    StateReplicator<UnitPool, Transform> Replicator(Server);
+    using View = StateReplicator<UnitPool, Transform>::ObserverView;
+    const View Views[] = { { 100, 100, 0, 60, 8192 }, { 500, 250, 0, 120, 8192 }, { 900, 450, 0, 40, 2048 } };
+    std::vector<std::unique_ptr<UnitPool>> Clients;
+    std::vector<ReplicaReceiver<UnitPool>> Receivers;
+    for (const View& Observer : Views) {
+        Replicator.AddObserver(Observer);
+        Receivers.emplace_back(*Clients.emplace_back(std::make_unique<UnitPool>()));
+    }
+
+    std::size_t Bytes = 0;
+    std::vector<std::byte> Packet;
+    constexpr int Ticks = 120;
+    for (int Tick = 0; Tick < Ticks; ++Tick) {
+        // Only every tenth chunk of units is moving.
+        for (std::size_t ChunkIndex = 0; ChunkIndex < Server.ChunkCount(); ChunkIndex += 10) {
+            Transform* Positions = Server.MutableColumn<Transform>(ChunkIndex);
+            for (std::uint32_t Slot = 0; Slot < Server.ChunkSize(ChunkIndex); ++Slot) Positions[Slot].Z = std::sin(Tick * 0.1f);
+        }
+        Bytes += Replicator.Tick(Transport);
+        Server.AdvanceVersion();
+        for (std::uint32_t Observer = 0; Observer < Receivers.size(); ++Observer) {
+            while (Transport.Receive(Observer, Packet)) Receivers[Observer].Apply(Packet);
+        }
+    }
+
+    std::cout << Label << ": " << Bytes / Ticks << " bytes/tick, replicas per observer:";
+    for (const auto& Receiver : Receivers) std::cout << " " << Receiver.Size();
+    std::cout << ", oversized attributes skipped: " << Replicator.OversizedAttributes() << "\n";
+
+    // Replicas are created with their names, except the one whose name never fits.
+    std::cout << "  OnCreate saw the default name on " << DefaultOnCreate << " replica" << std::endl;
+}
+
+int main() {
+    InProcessTransport InProcess(3);
+    RunSession("In-process", InProcess);
+#if defined(__unix__) || defined(__APPLE__)
+    UdpLoopbackTransport Loopback(3);
+    if (Loopback.Ok()) RunSession("UDP loopback", Loopback);
+#endif
+
+    // One record of an unknown kind, followed by bytes that would parse as an
+    // empty update mask.
+    std::vector<std::byte> Unknown(11, std::byte{});
+    Unknown[0] = std::byte{ 1 };
+    Unknown[6] = std::byte{ 7 };
+    UnitPool Client;
+    ReplicaReceiver<UnitPool> Receiver(Client);
+    std::cout << "Unknown record kind rejected: " << (!Receiver.Apply(Unknown) && Receiver.Size() == 0 ? "yes" : "no") << std::endl;
+    return 0;
+}
+
+#endif // REPLICATION_ENABLE_EXAMPLES
+
+#endif // STATE_REPLICATION_CPP
@@ -0,0 +1,354 @@
+#ifndef TEXT_IMPORT_CACHE_CPP
+#define TEXT_IMPORT_CACHE_CPP
+
+#include "attribute-serialization.cpp"
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// --- Tier 6: Text Import with a Binary Cache ---
+// Designers author objects as text, one block per object, keyed by the
+// Composition's SchemaName. Inside a block every line names an Attribute
+// followed by its field values in declaration order, or names a Role of the
+// Composition to document it. Attributes left out keep their defaults.
+//
+// Text files outlive compilers, so every name in them is a pinned SchemaName
+// (see type-ids.cpp), never TypeName<>(), whose spelling depends on the
+// compiler. The Composition must pin one; Attributes and Roles that do not
+// cannot be written in text.
+//
+//     # Props for the harbour
+//     Crate {
+//         Transform 12.5 0 -3
+//         Category "Harbour"
+//     }
+//
+// Parsing text is slow, so ImportCached() compiles a file once into the pool
+// file format of SavePool() and stores it under a key hashing the text and
+// the Composition's schema. Later startups load the binary form directly, and
+// only files whose contents (or schemas) changed are recompiled. Entries are
+// named after the text file's path too, and writing a new one deletes the
+// older entries for that path, so the cache holds one entry per text file.
+//
+// Imported and cached instances get the same lifecycle: the pool is filled
+// first, and OnCreate/OnEnable then run on it, seeing the final values.
+
+struct ImportResult {
+    bool Ok = false;
+    bool FromCache = false;
+    std::size_t Instances = 0;
+    std::string Error;
+};
+
+namespace TextImportDetail {
+    // Splits a line into whitespace or comma separated tokens. Quoted tokens
+    // keep their spaces and understand \" and \\ escapes.
+    inline bool Tokenize(std::string_view Line, std::vector<std::string>& Tokens) {
+        Tokens.clear();
+        std::size_t Cursor = 0;
+        while (Cursor < Line.size()) {
+            const char Next = Line[Cursor];
+            if (Next == ' ' || Next == '\t' || Next == ',' || Next == '\r') { ++Cursor; continue; }
+            if (Next == '#') break;
+            std::string& Token = Tokens.emplace_back();
+            if (Next != '"') {
+                while (Cursor < Line.size() && Line[Cursor] != ' ' && Line[Cursor] != '\t' && Line[Cursor] != ','
+                    && Line[Cursor] != '\r' && Line[Cursor] != '#') {
+                    Token.push_back(Line[Cursor++]);
+                }
+                continue;
+            }
+            Token.push_back('"'); // Marks the token as a string literal.
+            for (++Cursor; Cursor < Line.size() && Line[Cursor] != '"'; ++Cursor) {
+                if (Line[Cursor] == '\\' && Cursor + 1 < Line.size()) ++Cursor;
+                Token.push_back(Line[Cursor]);
+            }
+            if (Cursor == Line.size()) return false;
+            ++Cursor;
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool ParseField(const std::string& Token, F& Out) {
+        if constexpr (std::is_same_v<F, std::string>) {
+            if (Token.empty() || Token[0] != '"') return false;
+            Out.assign(Token, 1);
+            return true;
+        } else if constexpr (std::is_same_v<F, bool>) {
+            if (Token != "true" && Token != "false") return false;
+            Out = Token == "true";
+            return true;
+        } else if constexpr (std::is_enum_v<F>) {
+            std::underlying_type_t<F> Raw{};
+            if (!ParseField(Token, Raw)) return false;
+            Out = static_cast<F>(Raw);
+            return true;
+        } else {
+            const char* End = Token.data() + Token.size();
+            const auto [Stop, Status] = std::from_chars(Token.data(), End, Out);
+            return Status == std::errc() && Stop == End;
+        }
+    }
+
+    template <typename T, std::size_t... F>
+    bool ParseAttribute(const std::vector<std::string>& Tokens, T& Out, std::index_sequence<F...>) {
+        if (Tokens.size() != 1 + sizeof...(F)) return false;
+        auto Fields = TieFields(Out);
+        return (ParseField(Tokens[1 + F], std::get<F>(Fields)) && ...);
+    }
+
+    // Hex name of a 64-bit hash, for cache file names.
+    inline std::string HexKey(std::uint64_t Hash) {
+        char Key[17];
+        std::snprintf(Key, sizeof(Key), "%016llx", static_cast<unsigned long long>(Hash));
+        return Key;
+    }
+
+    template <typename TRolesList>
+    struct RoleNames;
+    template <typename... TRoles>
+    struct RoleNames<TypeList<TRoles...>> {
+        static bool Contains([[maybe_unused]] std::string_view Name) { return ((HasPinnedSchemaName<TRoles> && Name == SchemaNameOf<TRoles>()) || ...); }
+    };
+
+    // Appends the parsed instances to Pool without running lifecycle hooks.
+    template <typename TPool>
+    ImportResult ParseText(TPool& Pool, std::string_view Text) {
+        using TComposition = typename TPool::CompositionType;
+        static_assert(HasPinnedSchemaName<TComposition>,
+            "Import Error: Object blocks are keyed by the Composition's SchemaName, which it must pin.");
+        using Values = decltype([]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::tuple<typename TPool::template AttributeAt<I>...>{};
+        }(std::make_index_sequence<TPool::AttributeCount>{}));
+
+        ImportResult Result;
+        std::vector<std::string> Tokens;
+        Values Pending{};
+        bool InBlock = false, Matching = false;
+        std::size_t LineNumber = 0;
+        const auto Fail = [&](const char* Message) {
+            Result.Error = "line " + std::to_string(LineNumber) + ": " + Message;
+            return Result;
+        };
+
+        while (!Text.empty()) {
+            const std::size_t Break = Text.find('\n');
+            const std::string_view Line = Text.substr(0, Break);
+            Text.remove_prefix(Break == std::string_view::npos ? Text.size() : Break + 1);
+            ++LineNumber;
+            if (!Tokenize(Line, Tokens)) return Fail("unterminated string");
+            if (Tokens.empty()) continue;
+
+            if (!InBlock) {
+                if (Tokens.size() != 2 || Tokens[1] != "{") return Fail("expected '<Composition> {'");
+                InBlock = true;
+                Matching = Tokens[0] == SchemaNameOf<TComposition>();
+                Pending = Values{};
+                continue;
+            }
+            if (Tokens.size() == 1 && Tokens[0] == "}") {
+                if (Matching) {
+                    const std::size_t Index = Pool.AllocateDefault(1);
+                    [&]<std::size_t... I>(std::index_sequence<I...>) {
+                        ((Pool.template Attribute<typename TPool::template AttributeAt<I>>(Index) = std::move(std::get<I>(Pending))), ...);
+                    }(std::make_index_sequence<TPool::AttributeCount>{});
+                    ++Result.Instances;
+                }
+                InBlock = false;
+                continue;
+            }
+            if (!Matching) continue;
+
+            bool Known = false, Parsed = true;
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ([&] {
+                    using T = typename TPool::template AttributeAt<I>;
+                    if (Known || !HasPinnedSchemaName<T> || Tokens[0] != SchemaNameOf<T>()) return;
+                    Known = true;
+                    Parsed = ParseAttribute(Tokens, std::get<I>(Pending), std::make_index_sequence<FieldCount<T>>{});
+                }(), ...);
+            }(std::make_index_sequence<TPool::AttributeCount>{});
+            if (!Known && RoleNames<typename TComposition::RolesList>::Contains(Tokens[0])) {
+                if (Tokens.size() != 1) return Fail("roles take no values");
+                continue;
+            }
+            if (!Known) return Fail("unknown role or attribute");
+            if (!Parsed) return Fail("wrong number or type of field values");
+        }
+        if (InBlock) return Fail("missing '}'");
+        Result.Ok = true;
+        return Result;
+    }
+} // namespace TextImportDetail
+
+// Parses every object block for TPool's Composition in Text and appends it to
+// Pool. Blocks for other Compositions are skipped, so one file may hold
+// several object types. Hooks run once all blocks are in, also for the
+// blocks before an error.
+template <typename TPool>
+ImportResult ImportText(TPool& Pool, std::string_view Text) {
+    const std::size_t First = Pool.Size();
+    ImportResult Result = TextImportDetail::ParseText(Pool, Text);
+    Pool.RunSpawnHooks(First, Pool.Size() - First);
+    return Result;
+}
+
+// Loads TextPath through a binary cache in CacheDirectory, compiling the text
+// first if no cache entry matches its contents and the current schema. Both
+// ways append the instances in file order.
+template <typename TPool>
+ImportResult ImportCached(TPool& Pool, const std::string& TextPath, const std::string& CacheDirectory) {
+    std::vector<std::byte> Text;
+    if (!SerializationDetail::ReadFile(TextPath, Text)) return { false, false, 0, "cannot read " + TextPath };
+
+    using namespace TextImportDetail;
+    StateHasher ContentHasher(SchemaHashOf<TPool>());
+    ContentHasher.Append(Text.data(), Text.size());
+    // Entries of other pool types imported from the same file have their own
+    // prefix, so they are never evicted here.
+    StateHasher PathHasher(SchemaHashOf<TPool>());
+    PathHasher.Append(TextPath.data(), TextPath.size());
+    const std::string Prefix = HexKey(PathHasher.Finish()) + "-";
+    const std::filesystem::path CachePath = std::filesystem::path(CacheDirectory) / (Prefix + HexKey(ContentHasher.Finish()) + ".pool");
+
+    const std::size_t SizeBefore = Pool.Size();
+    if (LoadPool(Pool, CachePath.string())) {
+        return { true, true, Pool.Size() - SizeBefore, {} };
+    }
+
+    TPool Compiled;
+    ImportResult Result = ParseText(Compiled, std::string_view(reinterpret_cast<const char*>(Text.data()), Text.size()));
+    if (!Result.Ok) {
+        Result.Error = TextPath + ":" + Result.Error;
+        return Result;
+    }
+
+    // Write then rename, so a crash never leaves a truncated entry under the
+    // real key. A failed write leaves no staging file behind, and a new entry
+    // replaces the ones compiled from older contents of the same file.
+    std::error_code Error;
+    std::filesystem::create_directories(CacheDirectory, Error);
+    const std::filesystem::path Staging = CachePath.string() + ".tmp";
+    bool Cached = SavePool(Compiled, Staging.string());
+    if (Cached) {
+        std::filesystem::rename(Staging, CachePath, Error);
+        Cached = !Error;
+    }
+    if (!Cached) {
+        std::filesystem::remove(Staging, Error);
+    } else {
+        for (const auto& Entry : std::filesystem::directory_iterator(CacheDirectory, Error)) {
+            const std::string Name = Entry.path().filename().string();
+            if (Name.starts_with(Prefix) && Entry.path() != CachePath) std::filesystem::remove(Entry.path(), Error);
+        }
+    }
+
+    for (auto& Next : Compiled.ReleaseChunks()) Pool.AppendChunk(std::move(Next));
+    Pool.RunSpawnHooks(SizeBefore, Pool.Size() - SizeBefore);
+    return Result;
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef TEXT_IMPORT_ENABLE_EXAMPLES
+
+#include <chrono>
+#include <fstream>
+
+struct Transform : public Attribute {
+    static constexpr const char* SchemaName = "Transform";
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Category : public Attribute {
+    static constexpr const char* SchemaName = "Category";
+    std::string Name = "Default";
+};
+
+// Counts the crates whose OnCreate saw their imported Category.
+std::size_t CreatedWithValues = 0, CreatedWithDefaults = 0;
+
+class Logger : public Role {
+public:
+    static constexpr const char* SchemaName = "Logger";
+
+    template <typename THost>
+    void OnCreate(THost& Host) {
+        ++(Host.template Attribute<Category>().Name != "Default" ? CreatedWithValues : CreatedWithDefaults);
+    }
+};
+
+class Crate : public Composition<Crate, TypeList<Logger>, TypeList<Transform, Category>> {
+public:
+    static constexpr const char* SchemaName = "Crate";
+};
+
+using CratePool = CompositionPool<Crate>;
+
+class Buoy : public Composition<Buoy, TypeList<>, TypeList<Transform>> {
+public:
+    static constexpr const char* SchemaName = "Buoy";
+};
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    using Micro = std::chrono::microseconds;
+
+    const std::filesystem::path Directory = std::filesystem::temp_directory_path() / "composition-import";
+    const std::filesystem::path TextPath = Directory / "harbour.objects";
+    std::filesystem::remove_all(Directory);
+    std::filesystem::create_directories(Directory);
+    {
+        std::ofstream Text(TextPath);
+        Text << "# Generated harbour layout\n";
+        Text << "Buoy {\n    Transform 5, 0, 5\n}\n";
+        for (int Index = 0; Index < 20000; ++Index) {
+            Text << "Crate {\n    Logger\n    Transform " << Index * 0.5f << ", 0, " << -Index << "\n"
+                 << "    Category \"Harbour \\\"" << Index % 4 << "\\\"\"\n}\n";
+        }
+    }
+
+    // Compiled and cached, both starts see the crates in file order.
+    CratePool Pools[2];
+    bool InOrder = true;
+    for (const int Run : { 0, 1 }) {
+        CratePool& Pool = Pools[Run];
+        const auto Start = Clock::now();
+        const ImportResult Result = ImportCached(Pool, TextPath.string(), (Directory / "cache").string());
+        const auto Elapsed = std::chrono::duration_cast<Micro>(Clock::now() - Start).count();
+        for (std::size_t Index = 0; Index < Pool.Size(); ++Index) InOrder = InOrder && Pool.Attribute<Transform>(Index).Z == -float(Index);
+        std::cout << (Run == 0 ? "first start" : "second start") << ": " << (Result.Ok ? "" : Result.Error) << Result.Instances << " crates "
+                  << (Result.FromCache ? "from cache" : "compiled from text") << " in " << Elapsed << " us"
+                  << " (last is " << Pool.Attribute<Category>(Pool.Size() - 1).Name << ")\n";
+    }
+    std::cout << "Both starts in file order: " << (InOrder && Pools[0].Size() == Pools[1].Size() ? "yes" : "no") << "\n"
+              << "OnCreate saw imported values for " << CreatedWithValues << " crates, defaults for " << CreatedWithDefaults << "\n";
+
+    // Buoys from the same file get their own entry, and do not evict the crates'.
+    bool BuoysCached = true;
+    for (const int Run : { 0, 1 }) {
+        CompositionPool<Buoy> Buoys;
+        BuoysCached = ImportCached(Buoys, TextPath.string(), (Directory / "cache").string()).FromCache == (Run == 1) && BuoysCached;
+    }
+    CratePool Again;
+    std::cout << "Buoys cached beside crates: " << (BuoysCached && ImportCached(Again, TextPath.string(), (Directory / "cache").string()).FromCache ? "yes" : "no") << "\n";
+
+    // Editing the file compiles a new crate entry, which replaces the old one.
+    std::ofstream(TextPath, std::ios::app) << "Crate {\n    Transform 0, 0, 1\n}\n";
+    CratePool Edited;
+    const ImportResult Result = ImportCached(Edited, TextPath.string(), (Directory / "cache").string());
+    const auto Entries = std::distance(std::filesystem::directory_iterator(Directory / "cache"), std::filesystem::directory_iterator());
+    std::cout << "After an edit: " << Result.Instances << " crates " << (Result.FromCache ? "from cache" : "compiled from text")
+              << ", " << Entries << " cache entries (crates and buoys)" << std::endl;
+    std::filesystem::remove_all(Directory);
+    return 0;
+}
+
+#endif // TEXT_IMPORT_ENABLE_EXAMPLES
+
+#endif // TEXT_IMPORT_CACHE_CPP
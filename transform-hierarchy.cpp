@@ -0,0 +1,330 @@
+#ifndef TRANSFORM_HIERARCHY_CPP
+#define TRANSFORM_HIERARCHY_CPP
+
+#include "transform-trs.cpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// --- Tier 5: Transform Hierarchy ---
+// Attachments (a turret on a vehicle, a barrel on the turret) place their TRS
+// Attributes relative to a parent instance in the same pool. Such instances
+// also carry a Hierarchy Attribute, naming the parent's pool index, and a
+// LocalMatrix, which WorldMatrixUpdater<Pool, LocalMatrix> fills from their
+// TRS. TransformHierarchy then combines each LocalMatrix with the parent's
+// WorldMatrix.
+//
+// SortByDepth() reorders the pool breadth-first: all roots, then all their
+// children, then the grandchildren, and so on, with the children of one
+// parent next to each other. In that order every parent comes before its
+// children, so Propagate() is one linear pass per depth level instead of a
+// recursive walk, and the instances of one level do not depend on each
+// other: a level's range can be split across threads with StampLevel() and
+// PropagateRange().
+//
+// Pool indices are the parent links, so any structural change (Spawn,
+// Despawn, changing a Parent) must be followed by SortByDepth() before the
+// next Propagate(). When the order already holds it moves nothing. Never
+// call the pool's own Despawn() on a hierarchy: it moves the last instance
+// into the hole, which silently re-points the links to both. Use
+// TransformHierarchy::Despawn(), which removes the instance's whole subtree
+// and rewrites the remaining links.
+
+struct Hierarchy : public Attribute {
+    static constexpr std::uint32_t NoParent = 0xFFFFFFFFu;
+
+    std::uint32_t Parent = NoParent; // Pool index of the parent.
+    std::uint32_t Depth = 0;         // Set by SortByDepth(); roots are 0.
+};
+
+// The matrix of an instance's own TRS, relative to its parent.
+struct LocalMatrix : public WorldMatrix {};
+
+namespace HierarchyDetail {
+    // Out = Local * Parent, for row-major affine 4x3 matrices.
+    inline void Concatenate(const float (&Local)[4][3], const float (&Parent)[4][3], float (&Out)[4][3]) {
+        for (std::size_t Row = 0; Row < 4; ++Row) {
+            for (std::size_t Column = 0; Column < 3; ++Column) {
+                Out[Row][Column] = Local[Row][0] * Parent[0][Column] + Local[Row][1] * Parent[1][Column] + Local[Row][2] * Parent[2][Column]
+                                 + (Row == 3 ? Parent[3][Column] : 0.0f);
+            }
+        }
+    }
+} // namespace HierarchyDetail
+
+template <typename TPool>
+class TransformHierarchy {
+public:
+    static_assert(ContainsAll<typename TPool::CompositionType::AttributesList, TypeList<Hierarchy, LocalMatrix, WorldMatrix>>,
+        "Transform Error: TransformHierarchy needs a pool storing Hierarchy, LocalMatrix and WorldMatrix.");
+
+    // Reorders Pool breadth-first, rewrites the Parent links to the new
+    // indices and sets every Depth. Fails, leaving Pool unchanged, if a Parent
+    // is out of range or the links form a cycle.
+    bool SortByDepth(TPool& Pool) {
+        const TPool& Read = Pool;
+        const std::size_t Count = Pool.Size();
+
+        // Children of each instance, grouped by parent: those of I are
+        // Children[FirstChild[I] .. FirstChild[I + 1]).
+        std::vector<std::uint32_t> FirstChild(Count + 1, 0), Children(Count);
+        for (std::size_t Index = 0; Index < Count; ++Index) {
+            const std::uint32_t Parent = Read.template Attribute<Hierarchy>(Index).Parent;
+            if (Parent == Hierarchy::NoParent) continue;
+            if (Parent >= Count) return false;
+            ++FirstChild[Parent + 1];
+        }
+        for (std::size_t Index = 0; Index < Count; ++Index) FirstChild[Index + 1] += FirstChild[Index];
+        std::vector<std::uint32_t> Cursor(FirstChild.begin(), FirstChild.end() - 1);
+        std::vector<std::uint32_t> Order;
+        Order.reserve(Count);
+        for (std::size_t Index = 0; Index < Count; ++Index) {
+            const std::uint32_t Parent = Read.template Attribute<Hierarchy>(Index).Parent;
+            if (Parent == Hierarchy::NoParent) Order.push_back(static_cast<std::uint32_t>(Index));
+            else Children[Cursor[Parent]++] = static_cast<std::uint32_t>(Index);
+        }
+
+        // Breadth-first from the roots. Instances on a cycle are never reached.
+        std::vector<std::uint32_t> Depths(Count, 0);
+        LevelStarts.assign(1, 0);
+        for (std::size_t Position = 0; Position < Order.size(); ++Position) {
+            const std::uint32_t Index = Order[Position];
+            if (Position > 0 && Depths[Index] != Depths[Order[Position - 1]]) LevelStarts.push_back(Position);
+            for (std::uint32_t Child = FirstChild[Index]; Child < FirstChild[Index + 1]; ++Child) {
+                Depths[Children[Child]] = Depths[Index] + 1;
+                Order.push_back(Children[Child]);
+            }
+        }
+        if (Order.size() != Count) {
+            LevelStarts.clear();
+            return false;
+        }
+        LevelStarts.push_back(Count);
+
+        // Move every instance to its place, one swap per misplaced instance.
+        std::vector<std::uint32_t> NewIndex(Count), At(Count), Where(Count);
+        for (std::size_t Position = 0; Position < Count; ++Position) {
+            NewIndex[Order[Position]] = static_cast<std::uint32_t>(Position);
+            At[Position] = Where[Position] = static_cast<std::uint32_t>(Position);
+        }
+        for (std::size_t Position = 0; Position < Count; ++Position) {
+            const std::uint32_t From = Where[Order[Position]];
+            if (From == Position) continue;
+            Pool.Swap(Position, From);
+            std::swap(At[Position], At[From]);
+            Where[At[Position]] = static_cast<std::uint32_t>(Position);
+            Where[At[From]] = From;
+        }
+
+        for (std::size_t Position = 0; Position < Count; ++Position) {
+            const Hierarchy& Current = Read.template Attribute<Hierarchy>(Position);
+            const std::uint32_t Parent = Current.Parent == Hierarchy::NoParent ? Hierarchy::NoParent : NewIndex[Current.Parent];
+            const std::uint32_t Depth = Depths[Order[Position]];
+            if (Current.Parent != Parent || Current.Depth != Depth) Pool.template Attribute<Hierarchy>(Position) = Hierarchy{ {}, Parent, Depth };
+        }
+        return true;
+    }
+
+    // Despawns the instance at Index together with everything attached to it,
+    // directly or through other children, and rewrites the Parent links of
+    // the instances the pool moves into the holes. Returns the number of
+    // instances removed. Levels are stale afterwards until SortByDepth().
+    std::size_t Despawn(TPool& Pool, std::size_t Index) {
+        const TPool& Read = Pool;
+        const std::size_t Count = Pool.Size();
+
+        // Mark the subtree, pass by pass until nothing is added. When the pool
+        // is sorted (parents first) the first pass finds everything.
+        std::vector<bool> Removed(Count, false);
+        Removed[Index] = true;
+        for (bool Grew = true; Grew;) {
+            Grew = false;
+            for (std::size_t Candidate = 0; Candidate < Count; ++Candidate) {
+                const std::uint32_t Parent = Read.template Attribute<Hierarchy>(Candidate).Parent;
+                if (!Removed[Candidate] && Parent != Hierarchy::NoParent && Parent < Count && Removed[Parent]) {
+                    Removed[Candidate] = true;
+                    Grew = true;
+                }
+            }
+        }
+
+        // Despawn from the highest index down, so the pool only ever moves a
+        // surviving instance into a hole, and track where each one ends up.
+        std::vector<std::uint32_t> OriginalAt(Count);
+        for (std::size_t Position = 0; Position < Count; ++Position) OriginalAt[Position] = static_cast<std::uint32_t>(Position);
+        std::size_t RemovedCount = 0;
+        for (std::size_t Position = Count; Position-- > 0;) {
+            if (!Removed[Position]) continue;
+            const std::size_t Last = Pool.Size() - 1;
+            Pool.Despawn(Position);
+            OriginalAt[Position] = OriginalAt[Last];
+            ++RemovedCount;
+        }
+
+        std::vector<std::uint32_t> NewIndex(Count, Hierarchy::NoParent);
+        for (std::size_t Position = 0; Position < Pool.Size(); ++Position) NewIndex[OriginalAt[Position]] = static_cast<std::uint32_t>(Position);
+        for (std::size_t Position = 0; Position < Pool.Size(); ++Position) {
+            const Hierarchy& Current = Read.template Attribute<Hierarchy>(Position);
+            if (Current.Parent == Hierarchy::NoParent || Current.Parent >= Count) continue;
+            const std::uint32_t Parent = NewIndex[Current.Parent];
+            if (Parent != Current.Parent) Pool.template Attribute<Hierarchy>(Position).Parent = Parent;
+        }
+        LevelStarts.clear();
+        return RemovedCount;
+    }
+
+    // The pool index ranges of the depth levels after the last SortByDepth():
+    // level D is [Levels()[D], Levels()[D + 1]).
+    std::span<const std::size_t> Levels() const { return LevelStarts; }
+    std::size_t LevelCount() const { return LevelStarts.empty() ? 0 : LevelStarts.size() - 1; }
+
+    // WorldMatrix = LocalMatrix * the parent's WorldMatrix, level by level.
+    void Propagate(TPool& Pool) const {
+        for (std::size_t Level = 0; Level < LevelCount(); ++Level) PropagateRange(Pool, LevelStarts[Level], LevelStarts[Level + 1]);
+    }
+
+    // Propagates instances [Begin, End) of one level. Every level before it
+    // must be done. Ranges of the same level that share no chunk can run
+    // concurrently once StampLevel() has run for the level.
+    void PropagateRange(TPool& Pool, std::size_t Begin, std::size_t End) const {
+        const TPool& Read = Pool;
+        while (Begin < End) {
+            const std::size_t ChunkIndex = Begin / TPool::Capacity, First = Begin % TPool::Capacity;
+            const std::size_t Last = std::min<std::size_t>(End - ChunkIndex * TPool::Capacity, Pool.ChunkSize(ChunkIndex));
+            const Hierarchy* Links = Read.template Column<Hierarchy>(ChunkIndex);
+            const LocalMatrix* Locals = Read.template Column<LocalMatrix>(ChunkIndex);
+            WorldMatrix* Worlds = Pool.template MutableColumn<WorldMatrix>(ChunkIndex);
+            for (std::size_t Slot = First; Slot < Last; ++Slot) {
+                if (Links[Slot].Parent == Hierarchy::NoParent) {
+                    std::copy(&Locals[Slot].Rows[0][0], &Locals[Slot].Rows[0][0] + 12, &Worlds[Slot].Rows[0][0]);
+                } else {
+                    HierarchyDetail::Concatenate(Locals[Slot].Rows, Read.template Attribute<WorldMatrix>(Links[Slot].Parent).Rows, Worlds[Slot].Rows);
+                }
+            }
+            Begin = ChunkIndex * TPool::Capacity + Last;
+        }
+    }
+
+    // Stamps the WorldMatrix column of every chunk the level touches, so
+    // PropagateRange() calls on different chunks do not race on the pool's
+    // list of changed chunks.
+    void StampLevel(TPool& Pool, std::size_t Level) const {
+        if (LevelStarts[Level] == LevelStarts[Level + 1]) return;
+        const std::size_t FirstChunk = LevelStarts[Level] / TPool::Capacity, LastChunk = (LevelStarts[Level + 1] - 1) / TPool::Capacity;
+        for (std::size_t ChunkIndex = FirstChunk; ChunkIndex <= LastChunk; ++ChunkIndex) Pool.template MutableColumn<WorldMatrix>(ChunkIndex);
+    }
+
+private:
+    std::vector<std::size_t> LevelStarts;
+};
+
+
+// --- EXAMPLE USAGE ---
+#ifdef TRANSFORM_HIERARCHY_ENABLE_EXAMPLES
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+
+class Part : public Composition<Part, TypeList<>, TypeList<Position, Rotation, Scale, Hierarchy, LocalMatrix, WorldMatrix>> {};
+
+using PartPool = CompositionPool<Part>;
+
+// The world matrix of one instance by walking up its parents, as code
+// holding parent pointers does.
+static WorldMatrix WorldOf(const PartPool& Pool, std::size_t Index) {
+    const std::uint32_t Parent = Pool.Attribute<Hierarchy>(Index).Parent;
+    if (Parent == Hierarchy::NoParent) return Pool.Attribute<LocalMatrix>(Index);
+    WorldMatrix Result;
+    HierarchyDetail::Concatenate(Pool.Attribute<LocalMatrix>(Index).Rows, WorldOf(Pool, Parent).Rows, Result.Rows);
+    return Result;
+}
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    constexpr std::uint32_t Vehicles = 20000;
+
+    // Each vehicle carries a turret, which carries a barrel. They are spawned
+    // barrels first, the reverse of what propagation needs.
+    PartPool Pool;
+    const auto Spawn = [&](float X, float Y, float Z, float Yaw, std::uint32_t Parent) {
+        return static_cast<std::uint32_t>(Pool.Spawn(Position{{}, X, Y, Z}, Rotation{{}, 0.0f, std::sin(Yaw * 0.5f), 0.0f, std::cos(Yaw * 0.5f)},
+                                                     Scale{}, Hierarchy{{}, Parent, 0}, LocalMatrix{}, WorldMatrix{}));
+    };
+    std::mt19937 Random(5);
+    std::uniform_real_distribution<float> Place(-1000.0f, 1000.0f), Turn(-3.14159f, 3.14159f);
+    for (std::uint32_t Vehicle = 0; Vehicle < Vehicles; ++Vehicle) Spawn(2.0f, 0.0f, 0.0f, 0.0f, Vehicles + Vehicle);          // Barrels
+    for (std::uint32_t Vehicle = 0; Vehicle < Vehicles; ++Vehicle) Spawn(0.0f, 1.5f, 0.0f, Turn(Random), 2 * Vehicles + Vehicle); // Turrets
+    for (std::uint32_t Vehicle = 0; Vehicle < Vehicles; ++Vehicle) Spawn(Place(Random), 0.0f, Place(Random), Turn(Random), Hierarchy::NoParent);
+
+    TransformHierarchy<PartPool> Transforms;
+    WorldMatrixUpdater<PartPool, LocalMatrix> Locals;
+    if (!Transforms.SortByDepth(Pool)) return 1;
+    Locals.Update(Pool);
+
+    // Both fill every world matrix once per run; the best of ten runs each.
+    const auto Best = [](auto&& Run) {
+        Clock::duration Fastest = Clock::duration::max();
+        for (int Repeat = 0; Repeat < 10; ++Repeat) {
+            const auto Start = Clock::now();
+            Run();
+            Fastest = std::min(Fastest, Clock::now() - Start);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(Fastest).count();
+    };
+    std::vector<WorldMatrix> Walked(Pool.Size());
+    const auto LinearTime = Best([&] { Transforms.Propagate(Pool); });
+    const auto RecursiveTime = Best([&] {
+        for (std::size_t Index = 0; Index < Pool.Size(); ++Index) Walked[Index] = WorldOf(Pool, Index);
+    });
+
+    float Checksum = 0.0f;
+    bool Same = true;
+    for (std::size_t Index = 0; Index < Pool.Size(); ++Index) {
+        Checksum += Walked[Index].Rows[3][0];
+        Same = Same && std::abs(Walked[Index].Rows[3][0] - Pool.Attribute<WorldMatrix>(Index).Rows[3][0]) < 1e-3f;
+    }
+
+    // The same propagation with each level split at a chunk boundary between two threads.
+    for (std::size_t Level = 0; Level < Transforms.LevelCount(); ++Level) {
+        const std::size_t Begin = Transforms.Levels()[Level], End = Transforms.Levels()[Level + 1];
+        const std::size_t Split = std::clamp((Begin + End) / 2 / PartPool::Capacity * PartPool::Capacity, Begin, End);
+        Transforms.StampLevel(Pool, Level);
+        std::thread Helper([&] { Transforms.PropagateRange(Pool, Split, End); });
+        Transforms.PropagateRange(Pool, Begin, Split);
+        Helper.join();
+    }
+    for (std::size_t Index = 0; Index < Pool.Size(); Index += 101) {
+        Same = Same && std::abs(WorldOf(Pool, Index).Rows[3][2] - Pool.Attribute<WorldMatrix>(Index).Rows[3][2]) < 1e-3f;
+    }
+
+    // Scrapping a vehicle takes its turret and barrel along; the links of the
+    // parts moved into their slots still hold.
+    const std::size_t Scrapped = Transforms.Despawn(Pool, 0);
+    bool Relinked = Transforms.SortByDepth(Pool) && Pool.Size() == 3 * Vehicles - 3;
+    Locals.Update(Pool);
+    Transforms.Propagate(Pool);
+    for (std::size_t Index = 0; Index < Pool.Size(); ++Index) {
+        Relinked = Relinked && std::abs(WorldOf(Pool, Index).Rows[3][1] - Pool.Attribute<WorldMatrix>(Index).Rows[3][1]) < 1e-3f;
+    }
+
+    // The tip of the first barrel, one unit past its pivot along its local X.
+    const std::size_t Barrel = Transforms.Levels()[2];
+    float X = 1.0f, Y = 0.0f, Z = 0.0f;
+    Pool.Attribute<WorldMatrix>(Barrel).TransformPoint(X, Y, Z);
+    const Hierarchy& Link = Pool.Attribute<Hierarchy>(Barrel);
+
+    std::cout << Pool.Size() << " parts in " << Transforms.LevelCount() << " levels; barrel " << Barrel << " (depth " << Link.Depth
+              << ", turret " << Link.Parent << ") tip at (" << X << ", " << Y << ", " << Z << ")\n"
+              << "Level-order propagation: " << LinearTime << " us, recursive walk: " << RecursiveTime << " us (results "
+              << (Same ? "identical" : "differ") << ", checksum " << Checksum << ")\n"
+              << "Scrapping a vehicle removed " << Scrapped << " parts, links " << (Relinked ? "intact" : "BROKEN") << std::endl;
+    return 0;
+}
+
+#endif // TRANSFORM_HIERARCHY_ENABLE_EXAMPLES
+
+#endif // TRANSFORM_HIERARCHY_CPP
@@ -0,0 +1,251 @@
+#ifndef TYPE_IDS_CPP
+#define TYPE_IDS_CPP
+
+#include "role-based-design.cpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+// --- Tier 3: Stable Type Ids ---
+// Archetypes, save files and tools need to name Roles and Attributes at
+// runtime, without RTTI. Two kinds of identifier serve that:
+//
+// - TypeId<T> is a constexpr 64-bit FNV-1a hash of the type's stable name:
+//   T::SchemaName when it pins one, else TypeName<T>(). It is the same in
+//   every build made with one toolchain, and across toolchains for pinned
+//   names, so it can be stored and sent.
+// - DenseTypeIndex<TCategory, T>() numbers the types of one category
+//   (Attribute or Role) 0, 1, 2, ... in registration order, within one
+//   process. These indices address dispatch tables and the bits of a
+//   TypeMask in O(1).
+//
+// TypeRegistry<TCategory> maps stored ids back to dense indices and names.
+// It reports a hash collision (two names, one id) as an invalid index rather
+// than silently aliasing the types. DenseTypeIndex() never hands that index
+// out: a collision aborts with both names, since every caller uses the index
+// to address a table or a mask.
+
+// T pins its stable name with `static constexpr const char* SchemaName`.
+template <typename T>
+concept HasPinnedSchemaName = requires { T::SchemaName; };
+
+template <typename T>
+constexpr std::string_view SchemaNameOf() {
+    if constexpr (HasPinnedSchemaName<T>) return T::SchemaName;
+    else return TypeName<T>();
+}
+
+constexpr std::uint64_t HashTypeName(std::string_view Name) {
+    std::uint64_t Hash = 0xcbf29ce484222325ull;
+    for (const char Character : Name) {
+        Hash ^= static_cast<std::uint8_t>(Character);
+        Hash *= 0x100000001b3ull;
+    }
+    return Hash;
+}
+
+template <typename T>
+inline constexpr std::uint64_t TypeId = HashTypeName(SchemaNameOf<T>());
+
+inline constexpr std::uint32_t InvalidTypeIndex = ~std::uint32_t(0);
+
+template <typename TCategory>
+class TypeRegistry {
+public:
+    struct Entry {
+        std::uint64_t Id;
+        std::string_view Name;
+        std::size_t Size;
+        std::size_t Alignment;
+    };
+
+    static TypeRegistry& Get() {
+        static TypeRegistry Registry;
+        return Registry;
+    }
+
+    // Returns T's dense index, assigning the next one on first use.
+    template <typename T>
+    std::uint32_t Register() {
+        static_assert(std::is_base_of_v<TCategory, T>, "TypeRegistry Error: The type does not belong to this category.");
+        constexpr std::string_view Name = SchemaNameOf<T>();
+        std::lock_guard<std::mutex> Lock(Mutex);
+        const auto [Found, Inserted] = IndexById.try_emplace(TypeId<T>, static_cast<std::uint32_t>(Entries.size()));
+        if (!Inserted) return Entries[Found->second].Name == Name ? Found->second : InvalidTypeIndex;
+        Entries.push_back({ TypeId<T>, Name, sizeof(T), alignof(T) });
+        return Found->second;
+    }
+
+    std::uint32_t Find(std::uint64_t Id) const {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        const auto Found = IndexById.find(Id);
+        return Found == IndexById.end() ? InvalidTypeIndex : Found->second;
+    }
+
+    const Entry& At(std::uint32_t Index) const {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        return Entries[Index];
+    }
+
+    std::uint32_t Count() const {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        return static_cast<std::uint32_t>(Entries.size());
+    }
+
+private:
+    TypeRegistry() = default;
+
+    mutable std::mutex Mutex;
+    std::deque<Entry> Entries; // Never moves entries, so At() references stay valid.
+    std::unordered_map<std::uint64_t, std::uint32_t> IndexById;
+};
+
+// Cached after the first call, so steady-state lookups are a static load.
+template <typename TCategory, typename T>
+std::uint32_t DenseTypeIndex() {
+    static const std::uint32_t Index = [] {
+        TypeRegistry<TCategory>& Registry = TypeRegistry<TCategory>::Get();
+        const std::uint32_t Registered = Registry.template Register<T>();
+        if (Registered == InvalidTypeIndex) {
+            constexpr std::string_view Name = SchemaNameOf<T>();
+            const std::string_view Other = Registry.At(Registry.Find(TypeId<T>)).Name;
+            std::fprintf(stderr, "TypeRegistry Error: '%.*s' and '%.*s' hash to the same TypeId; pin a different SchemaName.\n",
+                         static_cast<int>(Name.size()), Name.data(), static_cast<int>(Other.size()), Other.data());
+            std::abort();
+        }
+        return Registered;
+    }();
+    return Index;
+}
+
+template <typename T>
+std::uint32_t AttributeIndex() { return DenseTypeIndex<Attribute, T>(); }
+
+template <typename T>
+std::uint32_t RoleIndex() { return DenseTypeIndex<Role, T>(); }
+
+// A set of dense type indices below MaxTypes, e.g. the Attributes of an
+// archetype. Dense indices are process-wide, so a process registering more
+// than MaxTypes types of one category needs a wider mask; Set and Test abort
+// on an index past the mask rather than corrupt memory.
+template <std::size_t MaxTypes = 256>
+class TypeMask {
+public:
+    static constexpr std::size_t Capacity = MaxTypes;
+
+    void Set(std::uint32_t Index) {
+        CheckIndex(Index);
+        Words[Index / 64] |= std::uint64_t(1) << (Index % 64);
+    }
+    bool Test(std::uint32_t Index) const {
+        CheckIndex(Index);
+        return (Words[Index / 64] >> (Index % 64)) & 1;
+    }
+
+    bool ContainsAll(const TypeMask& Other) const {
+        for (std::size_t Word = 0; Word < WordCount; ++Word) {
+            if ((Words[Word] & Other.Words[Word]) != Other.Words[Word]) return false;
+        }
+        return true;
+    }
+
+    bool Intersects(const TypeMask& Other) const {
+        for (std::size_t Word = 0; Word < WordCount; ++Word) {
+            if (Words[Word] & Other.Words[Word]) return true;
+        }
+        return false;
+    }
+
+    bool operator==(const TypeMask&) const = default;
+
+private:
+    static constexpr std::size_t WordCount = (MaxTypes + 63) / 64;
+
+    // Checked in every build: an out-of-range bit would write past Words.
+    static void CheckIndex(std::uint32_t Index) {
+        if (Index < MaxTypes) return;
+        std::fprintf(stderr, "TypeMask Error: Dense type index %u is out of range for a %zu-type mask.\n",
+                     static_cast<unsigned>(Index), MaxTypes);
+        std::abort();
+    }
+    std::array<std::uint64_t, WordCount> Words{};
+};
+
+using AttributeMask = TypeMask<>;
+
+template <typename TList>
+struct TypeMaskOf;
+template <typename... T>
+struct TypeMaskOf<TypeList<T...>> {
+    static AttributeMask Build() {
+        AttributeMask Mask;
+        (Mask.Set(AttributeIndex<T>()), ...);
+        return Mask;
+    }
+};
+
+// The archetype signature of a Composition: one bit per Attribute.
+template <typename TComposition>
+const AttributeMask& AttributeSignatureOf() {
+    static const AttributeMask Signature = TypeMaskOf<typename TComposition::AttributesList>::Build();
+    return Signature;
+}
+
+
+// --- EXAMPLE USAGE ---
+#ifdef TYPE_IDS_ENABLE_EXAMPLES
+
+#include <functional>
+#include <vector>
+
+struct Transform : public Attribute {
+    static constexpr const char* SchemaName = "Transform";
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Velocity : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Health : public Attribute {
+    int Points = 100;
+};
+
+class Rock : public Composition<Rock, TypeList<>, TypeList<Transform>> {};
+class Bullet : public Composition<Bullet, TypeList<>, TypeList<Transform, Velocity>> {};
+class Soldier : public Composition<Soldier, TypeList<>, TypeList<Transform, Velocity, Health>> {};
+
+static_assert(TypeId<Transform> == HashTypeName("Transform"), "Pinned names hash identically everywhere.");
+static_assert(TypeId<Velocity> != TypeId<Health>);
+
+int main() {
+    // A table indexed by dense Attribute index, filled at startup.
+    std::vector<std::function<void()>> Describe(8);
+    Describe[AttributeIndex<Transform>()] = [] { std::cout << "a position"; };
+    Describe[AttributeIndex<Velocity>()] = [] { std::cout << "a velocity"; };
+    Describe[AttributeIndex<Health>()] = [] { std::cout << "hit points"; };
+
+    // An id read from a file resolves to the table slot without RTTI.
+    const std::uint64_t Stored = TypeId<Velocity>;
+    const std::uint32_t Index = TypeRegistry<Attribute>::Get().Find(Stored);
+    std::cout << "Id " << std::hex << Stored << std::dec << " is " << TypeRegistry<Attribute>::Get().At(Index).Name << ", ";
+    Describe[Index]();
+    std::cout << "\n";
+
+    // Archetype queries are mask tests.
+    AttributeMask Moving;
+    Moving.Set(AttributeIndex<Transform>());
+    Moving.Set(AttributeIndex<Velocity>());
+    std::cout << "Moving archetypes: rock " << AttributeSignatureOf<Rock>().ContainsAll(Moving)
+              << ", bullet " << AttributeSignatureOf<Bullet>().ContainsAll(Moving)
+              << ", soldier " << AttributeSignatureOf<Soldier>().ContainsAll(Moving) << std::endl;
+    return 0;
+}
+
+#endif // TYPE_IDS_ENABLE_EXAMPLES
+
+#endif // TYPE_IDS_CPP
@@ -0,0 +1,286 @@
+#ifndef TYPE_LIST_CPP
+#define TYPE_LIST_CPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define TYPELIST_HAS_PACK_ELEMENT 1
+#endif
+#endif
+
+// --- Tier 0: TypeList Algorithms ---
+// Compositions are described by lists of Roles and Attributes, and every rule
+// check walks those lists. Recursive "head + tail" metafunctions instantiate
+// one class per element, per query, nested as deep as the list is long. With
+// lists of 60+ Attributes that dominates compile time and runs into depth
+// limits.
+//
+// Every algorithm here has constant instantiation depth instead:
+// - Membership and index queries are pack folds or loops over constexpr bool
+//   arrays.
+// - Element access resolves an overload against a class that inherits one
+//   base per (index, type) pair, or uses the compiler builtin where available.
+// - Concat folds an operator over the lists inside decltype, ConcatBlock
+//   lists at a time. Longer packs are folded block by block and the blocks
+//   concatenated the same way, so expression nesting stays within
+//   compiler limits (256 in clang) and grows only logarithmically. Filter,
+//   Unique and Difference are a single Concat of zero-or-one-element lists.
+// - SortBy stable-sorts an index array in a constexpr function and expands
+//   the permutation once.
+
+template <typename... T>
+struct TypeList {};
+
+enum class SortOrder { Ascending, Descending };
+
+namespace TypeListDetail {
+    template <typename TList>
+    struct Size;
+    template <typename... Ts>
+    struct Size<TypeList<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+    template <typename T, typename TList>
+    struct Find;
+    template <typename T, typename... Ts>
+    struct Find<T, TypeList<Ts...>> {
+        static constexpr bool Any = (std::is_same_v<T, Ts> || ...);
+        static constexpr std::size_t First() {
+            constexpr bool Matches[] = { std::is_same_v<T, Ts>..., false };
+            std::size_t Index = 0;
+            while (Index < sizeof...(Ts) && !Matches[Index]) ++Index;
+            return Index;
+        }
+    };
+
+    // --- Element access ---
+    template <std::size_t I, typename T>
+    struct Indexed {
+        using Type = T;
+    };
+
+    template <typename TIndices, typename... Ts>
+    struct IndexedPack;
+    template <std::size_t... I, typename... Ts>
+    struct IndexedPack<std::index_sequence<I...>, Ts...> : Indexed<I, Ts>... {};
+
+    template <std::size_t I, typename T>
+    Indexed<I, T> Select(const Indexed<I, T>&); // Unevaluated only.
+
+    template <typename TList, std::size_t I>
+    struct At;
+    template <typename... Ts, std::size_t I>
+    struct At<TypeList<Ts...>, I> {
+        static_assert(I < sizeof...(Ts), "TypeList Error: Index out of range.");
+#ifdef TYPELIST_HAS_PACK_ELEMENT
+        using Type = __type_pack_element<I, Ts...>;
+#else
+        using Type = typename decltype(Select<I>(IndexedPack<std::index_sequence_for<Ts...>, Ts...>{}))::Type;
+#endif
+    };
+
+    // --- Concatenation ---
+    template <typename TList>
+    struct Wrap {};
+
+    template <typename... A, typename... B>
+    Wrap<TypeList<A..., B...>> operator+(Wrap<TypeList<A...>>, Wrap<TypeList<B...>>); // Unevaluated only.
+
+    template <typename TWrapped>
+    struct Unwrap;
+    template <typename TList>
+    struct Unwrap<Wrap<TList>> {
+        using Type = TList;
+    };
+
+    inline constexpr std::size_t ConcatBlock = 16;
+
+    template <typename... TLists>
+    struct FoldConcat {
+        using Type = typename Unwrap<decltype((Wrap<TLists>{} + ... + Wrap<TypeList<>>{}))>::Type;
+    };
+
+    // The I-th list of TPack, or an empty list past its end.
+    template <typename TPack, std::size_t I, bool InRange = (I < Size<TPack>::value)>
+    struct ListAt {
+        using Type = TypeList<>;
+    };
+    template <typename TPack, std::size_t I>
+    struct ListAt<TPack, I, true> {
+        using Type = typename At<TPack, I>::Type;
+    };
+
+    template <typename TPack, std::size_t Block, typename TOffsets = std::make_index_sequence<ConcatBlock>>
+    struct FoldBlock;
+    template <typename TPack, std::size_t Block, std::size_t... K>
+    struct FoldBlock<TPack, Block, std::index_sequence<K...>> {
+        using Type = typename FoldConcat<typename ListAt<TPack, Block * ConcatBlock + K>::Type...>::Type;
+    };
+
+    template <typename... TLists>
+    struct ConcatTree;
+
+    template <typename TPack, typename TBlocks = std::make_index_sequence<(Size<TPack>::value + ConcatBlock - 1) / ConcatBlock>>
+    struct ConcatBlocks;
+    template <typename TPack, std::size_t... B>
+    struct ConcatBlocks<TPack, std::index_sequence<B...>> {
+        using Type = typename ConcatTree<typename FoldBlock<TPack, B>::Type...>::Type;
+    };
+
+    template <typename... TLists>
+    struct ConcatTree
+        : std::conditional_t<(sizeof...(TLists) <= ConcatBlock), FoldConcat<TLists...>, ConcatBlocks<TypeList<TLists...>>> {};
+
+    template <typename... TLists>
+    using Concat = typename ConcatTree<TLists...>::Type;
+
+    template <bool Keep, typename T>
+    using Maybe = std::conditional_t<Keep, TypeList<T>, TypeList<>>;
+
+    template <typename TList, template <typename> class TPredicate>
+    struct Filter;
+    template <typename... Ts, template <typename> class TPredicate>
+    struct Filter<TypeList<Ts...>, TPredicate> {
+        using Type = Concat<Maybe<bool(TPredicate<Ts>::value), Ts>...>;
+    };
+
+    // Keeps each type at its first occurrence only.
+    template <typename TList, typename TIndices = std::make_index_sequence<Size<TList>::value>>
+    struct Unique;
+    template <typename... Ts, std::size_t... I>
+    struct Unique<TypeList<Ts...>, std::index_sequence<I...>> {
+        using Type = Concat<Maybe<Find<Ts, TypeList<Ts...>>::First() == I, Ts>...>;
+    };
+
+    template <typename TList, typename TRemove>
+    struct Difference;
+    template <typename... Ts, typename TRemove>
+    struct Difference<TypeList<Ts...>, TRemove> {
+        using Type = Concat<Maybe<!Find<Ts, TRemove>::Any, Ts>...>;
+    };
+
+    template <typename TList, typename TSubset>
+    struct ContainsAll;
+    template <typename TList, typename... Ts>
+    struct ContainsAll<TList, TypeList<Ts...>> : std::bool_constant<(Find<Ts, TList>::Any && ...)> {};
+
+    // --- Sorting ---
+    template <std::size_t N>
+    constexpr std::array<std::size_t, N> StableOrder(const std::array<std::intmax_t, N>& Keys, bool Descending) {
+        std::array<std::size_t, N> Order{};
+        for (std::size_t Index = 0; Index < N; ++Index) {
+            std::size_t Slot = Index;
+            while (Slot > 0 && (Descending ? Keys[Order[Slot - 1]] < Keys[Index] : Keys[Order[Slot - 1]] > Keys[Index])) {
+                Order[Slot] = Order[Slot - 1];
+                --Slot;
+            }
+            Order[Slot] = Index;
+        }
+        return Order;
+    }
+
+    template <typename TList, template <typename> class TKey, SortOrder Order,
+              typename TIndices = std::make_index_sequence<Size<TList>::value>>
+    struct SortBy;
+    template <typename... Ts, template <typename> class TKey, SortOrder Order, std::size_t... I>
+    struct SortBy<TypeList<Ts...>, TKey, Order, std::index_sequence<I...>> {
+        static constexpr std::array<std::size_t, sizeof...(Ts)> Permutation =
+            StableOrder<sizeof...(Ts)>({ static_cast<std::intmax_t>(TKey<Ts>::value)... }, Order == SortOrder::Descending);
+        using Type = TypeList<typename At<TypeList<Ts...>, Permutation[I]>::Type...>;
+    };
+} // namespace TypeListDetail
+
+// --- Queries ---
+template <typename TList>
+inline constexpr std::size_t ListSize = TypeListDetail::Size<TList>::value;
+
+template <typename TList, typename T>
+inline constexpr bool Contains = TypeListDetail::Find<T, TList>::Any;
+
+// Every type of TSubset appears in TList.
+template <typename TList, typename TSubset>
+inline constexpr bool ContainsAll = TypeListDetail::ContainsAll<TList, TSubset>::value;
+
+// Position of the first T in TList, or ListSize<TList> if absent.
+template <typename TList, typename T>
+inline constexpr std::size_t IndexOf = TypeListDetail::Find<T, TList>::First();
+
+template <typename TList, std::size_t I>
+using TypeAt = typename TypeListDetail::At<TList, I>::Type;
+
+// --- Transformations ---
+template <typename... TLists>
+using Concat = TypeListDetail::Concat<TLists...>;
+
+// The types T of TList for which TPredicate<T>::value holds, in order.
+template <typename TList, template <typename> class TPredicate>
+using Filter = typename TypeListDetail::Filter<TList, TPredicate>::Type;
+
+template <typename TList>
+using Unique = typename TypeListDetail::Unique<TList>::Type;
+
+// TList without the types that appear in TRemove.
+template <typename TList, typename TRemove>
+using Difference = typename TypeListDetail::Difference<TList, TRemove>::Type;
+
+// Stable sort by TKey<T>::value, e.g. SortBy<TList, AlignmentOf, SortOrder::Descending>.
+template <typename TList, template <typename> class TKey, SortOrder Order = SortOrder::Ascending>
+using SortBy = typename TypeListDetail::SortBy<TList, TKey, Order>::Type;
+
+template <typename T>
+struct SizeOf : std::integral_constant<std::size_t, sizeof(T)> {};
+
+template <typename T>
+struct AlignmentOf : std::integral_constant<std::size_t, alignof(T)> {};
+
+
+// --- EXAMPLE USAGE ---
+#ifdef TYPELIST_ENABLE_EXAMPLES
+
+#include <iostream>
+#include <string>
+
+struct Small { char Value; };
+struct Wide { double Values[4]; };
+struct alignas(32) Vector { float Lanes[8]; };
+
+template <typename T>
+using IsPlain = std::is_trivially_copyable<T>;
+
+using Mixed = TypeList<Small, Wide, Vector, Small, int>;
+
+static_assert(Contains<Mixed, Wide> && !Contains<Mixed, float>);
+static_assert(ContainsAll<Mixed, TypeList<int, Small>>);
+static_assert(IndexOf<Mixed, Vector> == 2 && IndexOf<Mixed, float> == ListSize<Mixed>);
+static_assert(std::is_same_v<TypeAt<Mixed, 4>, int>);
+static_assert(std::is_same_v<Concat<TypeList<int>, TypeList<>, TypeList<char, int>>, TypeList<int, char, int>>);
+static_assert(std::is_same_v<Unique<Mixed>, TypeList<Small, Wide, Vector, int>>);
+static_assert(std::is_same_v<Difference<Mixed, TypeList<Small>>, TypeList<Wide, Vector, int>>);
+static_assert(std::is_same_v<Filter<TypeList<int, std::string, Wide>, IsPlain>, TypeList<int, Wide>>);
+static_assert(std::is_same_v<SortBy<Unique<Mixed>, AlignmentOf, SortOrder::Descending>, TypeList<Vector, Wide, int, Small>>);
+static_assert(std::is_same_v<SortBy<Unique<Mixed>, SizeOf>, TypeList<Small, int, Wide, Vector>>);
+
+// A 300-element list stays flat: no query recurses per element.
+template <std::size_t I>
+struct Tag {};
+
+template <std::size_t... I>
+TypeList<Tag<I>...> MakeTags(std::index_sequence<I...>);
+
+using Large = decltype(MakeTags(std::make_index_sequence<300>{}));
+static_assert(IndexOf<Large, Tag<299>> == 299);
+static_assert(ListSize<Unique<Concat<Large, Large>>> == 300);
+static_assert(std::is_same_v<TypeAt<Difference<Concat<Large, Large>, TypeList<Tag<0>>>, 597>, Tag<299>>);
+
+int main() {
+    std::cout << "TypeList checks passed at compile time for lists of up to " << ListSize<Concat<Large, Large>> << " types" << std::endl;
+    return 0;
+}
+
+#endif // TYPELIST_ENABLE_EXAMPLES
+
+#endif // TYPE_LIST_CPP
@@ -0,0 +1,427 @@
+#ifndef WORLD_STATE_HASH_CPP
+#define WORLD_STATE_HASH_CPP
+
+#include "aggregate-reflection.cpp"
+#include "composition-pool.cpp"
+#include "simd-transform-kernels.cpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// --- Tier 4: World State Hashing ---
+// A deterministic checksum of everything stored in a CompositionPool, cheap
+// enough to compare between lockstep peers (or against a replay) every frame.
+//
+// The byte hash runs eight independent 32-bit xxHash-style lanes over 32-byte
+// blocks, so the SSE2 and AVX2 kernels picked by HashKernels() produce exactly
+// the scalar result. The input is read as little-endian words; peers must
+// share byte order.
+//
+// Every chunk is hashed on its own, seeded with its index, and the hashes of
+// the non-empty chunks are folded in index order. The result therefore does
+// not depend on how many threads computed it or on empty chunks left behind
+// by earlier despawns, and chunks whose version is unchanged reuse their hash.
+
+// One kernel: folds BlockCount 32-byte blocks into the eight lanes of State.
+struct HashKernelTable {
+    SimdLevel Level;
+    void (*HashBlocks)(std::uint32_t* State, const std::byte* Data, std::size_t BlockCount);
+};
+
+namespace WorldHashDetail {
+    constexpr std::uint32_t Prime1 = 2654435761u;
+    constexpr std::uint32_t Prime2 = 2246822519u;
+    constexpr std::size_t BlockSize = 32;
+
+    inline void HashBlocksScalar(std::uint32_t* State, const std::byte* Data, std::size_t BlockCount) {
+        for (std::size_t Block = 0; Block < BlockCount; ++Block) {
+            for (std::uint32_t Lane = 0; Lane < 8; ++Lane) {
+                std::uint32_t Word;
+                std::memcpy(&Word, Data + Block * BlockSize + Lane * sizeof(Word), sizeof(Word));
+                const std::uint32_t Mixed = State[Lane] + Word * Prime2;
+                State[Lane] = ((Mixed << 13) | (Mixed >> 19)) * Prime1;
+            }
+        }
+    }
+
+#ifdef SIMD_TRANSFORM_X86
+    // SSE2 has no 32-bit low multiply: multiply the even and odd lanes into
+    // 64-bit products and gather their low halves.
+    SIMD_TARGET("sse2") inline __m128i MultiplyLowSSE2(__m128i A, __m128i B) {
+        const __m128i Even = _mm_mul_epu32(A, B);
+        const __m128i Odd = _mm_mul_epu32(_mm_srli_si128(A, 4), _mm_srli_si128(B, 4));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(Even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(Odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    SIMD_TARGET("sse2") inline void HashBlocksSSE2(std::uint32_t* State, const std::byte* Data, std::size_t BlockCount) {
+        const __m128i P1 = _mm_set1_epi32(static_cast<int>(Prime1));
+        const __m128i P2 = _mm_set1_epi32(static_cast<int>(Prime2));
+        __m128i Low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(State));
+        __m128i High = _mm_loadu_si128(reinterpret_cast<const __m128i*>(State + 4));
+        for (std::size_t Block = 0; Block < BlockCount; ++Block) {
+            const std::byte* Words = Data + Block * BlockSize;
+            Low = _mm_add_epi32(Low, MultiplyLowSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Words)), P2));
+            High = _mm_add_epi32(High, MultiplyLowSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Words + 16)), P2));
+            Low = MultiplyLowSSE2(_mm_or_si128(_mm_slli_epi32(Low, 13), _mm_srli_epi32(Low, 19)), P1);
+            High = MultiplyLowSSE2(_mm_or_si128(_mm_slli_epi32(High, 13), _mm_srli_epi32(High, 19)), P1);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(State), Low);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(State + 4), High);
+    }
+
+    SIMD_TARGET("avx2") inline void HashBlocksAVX2(std::uint32_t* State, const std::byte* Data, std::size_t BlockCount) {
+        const __m256i P1 = _mm256_set1_epi32(static_cast<int>(Prime1));
+        const __m256i P2 = _mm256_set1_epi32(static_cast<int>(Prime2));
+        __m256i Acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(State));
+        for (std::size_t Block = 0; Block < BlockCount; ++Block) {
+            const __m256i Words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data + Block * BlockSize));
+            Acc = _mm256_add_epi32(Acc, _mm256_mullo_epi32(Words, P2));
+            Acc = _mm256_or_si256(_mm256_slli_epi32(Acc, 13), _mm256_srli_epi32(Acc, 19));
+            Acc = _mm256_mullo_epi32(Acc, P1);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(State), Acc);
+    }
+#endif // SIMD_TRANSFORM_X86
+} // namespace WorldHashDetail
+
+// The kernels for Level. The eight lanes fill one AVX2 register, so the
+// AVX-512 table uses the AVX2 kernel.
+inline const HashKernelTable& HashKernelsFor(SimdLevel Level) {
+    using namespace WorldHashDetail;
+    static const HashKernelTable Scalar{ SimdLevel::Scalar, &HashBlocksScalar };
+#ifdef SIMD_TRANSFORM_X86
+    static const HashKernelTable Sse2{ SimdLevel::SSE2, &HashBlocksSSE2 };
+    static const HashKernelTable Avx2{ SimdLevel::AVX2, &HashBlocksAVX2 };
+    static const HashKernelTable Avx512{ SimdLevel::AVX512, &HashBlocksAVX2 };
+    switch (Level) {
+        case SimdLevel::SSE2: return Sse2;
+        case SimdLevel::AVX2: return Avx2;
+        case SimdLevel::AVX512: return Avx512;
+        default: break;
+    }
+#endif
+    (void)Level;
+    return Scalar;
+}
+
+inline const HashKernelTable& HashKernels() {
+    static const HashKernelTable& Best = HashKernelsFor(DetectSimdLevel());
+    return Best;
+}
+
+class StateHasher {
+public:
+    explicit StateHasher(std::uint64_t Seed = 0, const HashKernelTable& InKernels = HashKernels()) : Kernels(&InKernels) {
+        for (std::uint32_t Lane = 0; Lane < LaneCount; ++Lane) {
+            Lanes[Lane] = static_cast<std::uint32_t>(Seed) + WorldHashDetail::Prime1 * (Lane + 1) + static_cast<std::uint32_t>(Seed >> 32);
+        }
+    }
+
+    void Append(const void* Data, std::size_t Size) {
+        const std::byte* Bytes = static_cast<const std::byte*>(Data);
+        TotalSize += Size;
+        if (PendingSize > 0) {
+            const std::size_t Fill = Size < BlockSize - PendingSize ? Size : BlockSize - PendingSize;
+            std::memcpy(Pending + PendingSize, Bytes, Fill);
+            PendingSize += Fill;
+            Bytes += Fill;
+            Size -= Fill;
+            if (PendingSize < BlockSize) return;
+            Kernels->HashBlocks(Lanes, Pending, 1);
+            PendingSize = 0;
+        }
+        const std::size_t BlockCount = Size / BlockSize;
+        Kernels->HashBlocks(Lanes, Bytes, BlockCount);
+        PendingSize = Size - BlockCount * BlockSize;
+        std::memcpy(Pending, Bytes + BlockCount * BlockSize, PendingSize);
+    }
+
+    template <typename T>
+    void AppendValue(const T& Value) {
+        static_assert(std::is_trivially_copyable_v<T>, "StateHasher Error: AppendValue() needs a trivially copyable type.");
+        Append(&Value, sizeof(T));
+    }
+
+    std::uint64_t Finish() const {
+        std::uint32_t Final[LaneCount];
+        std::memcpy(Final, Lanes, sizeof(Final));
+        if (PendingSize > 0) {
+            std::byte Tail[BlockSize] = {};
+            std::memcpy(Tail, Pending, PendingSize);
+            Kernels->HashBlocks(Final, Tail, 1);
+        }
+        std::uint64_t Hash = TotalSize;
+        for (std::uint32_t Lane = 0; Lane < LaneCount; ++Lane) {
+            Hash = (Hash ^ Final[Lane]) * 0x9E3779B97F4A7C15ull;
+            Hash ^= Hash >> 29;
+        }
+        Hash ^= Hash >> 33;
+        Hash *= 0xFF51AFD7ED558CCDull;
+        Hash ^= Hash >> 33;
+        Hash *= 0xC4CEB9FE1A85EC53ull;
+        return Hash ^ (Hash >> 33);
+    }
+
+private:
+    static constexpr std::uint32_t LaneCount = 8;
+    static constexpr std::size_t BlockSize = WorldHashDetail::BlockSize;
+
+    const HashKernelTable* Kernels;
+    alignas(32) std::uint32_t Lanes[LaneCount];
+    std::byte Pending[BlockSize];
+    std::size_t PendingSize = 0;
+    std::uint64_t TotalSize = 0;
+};
+
+// Attributes that are not trivially copyable (or that contain padding, whose
+// bytes are unspecified) provide a HashValue() overload found by ADL.
+inline void HashValue(StateHasher& Hasher, const std::string& Value) {
+    Hasher.AppendValue(static_cast<std::uint64_t>(Value.size()));
+    Hasher.Append(Value.data(), Value.size());
+}
+
+template <typename T>
+concept HasStateHash = requires(StateHasher& Hasher, const T& Value) { HashValue(Hasher, Value); };
+
+namespace WorldHashDetail {
+    template <typename T>
+    constexpr bool IsPaddingFree();
+
+    template <typename T, typename TFields>
+    struct FieldsFill;
+
+    template <typename T, typename... TFields>
+    struct FieldsFill<T, std::tuple<TFields...>>
+        : std::bool_constant<(IsPaddingFree<std::remove_cvref_t<TFields>>() && ...) && (sizeof(std::remove_cvref_t<TFields>) + ... + 0) == sizeof(T)> {};
+
+    // True if every byte of T belongs to a field. Floats count, although
+    // +0/-0 and NaN payloads compare equal with different bytes; aggregates
+    // TieFields accepts are checked field by field.
+    template <typename T>
+    constexpr bool IsPaddingFree() {
+        if constexpr (std::has_unique_object_representations_v<T> || std::is_floating_point_v<T>) return true;
+        else if constexpr (std::is_array_v<T>) return IsPaddingFree<std::remove_extent_t<T>>();
+        else if constexpr (IsReflectable<T>) return FieldsFill<T, decltype(TieFields(std::declval<T&>()))>::value;
+        else return false;
+    }
+} // namespace WorldHashDetail
+
+template <typename T>
+void HashColumn(StateHasher& Hasher, const T* Values, std::uint32_t Count) {
+    if constexpr (HasStateHash<T>) {
+        for (std::uint32_t Slot = 0; Slot < Count; ++Slot) HashValue(Hasher, Values[Slot]);
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "StateHasher Error: An Attribute is not trivially copyable and has no HashValue() overload.");
+        static_assert(WorldHashDetail::IsPaddingFree<T>(),
+            "StateHasher Error: An Attribute has padding bytes (or more than MaxReflectedFields fields); give it a HashValue() overload.");
+        Hasher.Append(Values, sizeof(T) * Count);
+    }
+}
+
+template <typename TPool>
+class WorldStateHasher {
+public:
+    explicit WorldStateHasher(const TPool& InPool, std::uint64_t InSeed = 0, const HashKernelTable& InKernels = HashKernels())
+        : Pool(InPool), Seed(InSeed), Kernels(InKernels) {}
+
+    ~WorldStateHasher() {
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            Stopping = true;
+        }
+        Wake.notify_all();
+        for (std::thread& Helper : Helpers) Helper.join();
+    }
+
+    WorldStateHasher(const WorldStateHasher&) = delete;
+    WorldStateHasher& operator=(const WorldStateHasher&) = delete;
+
+    // Hashes the whole pool. Chunks stamped since the previous call (or with
+    // the still-open pool version) are rehashed, split across ThreadCount
+    // threads once there are enough of them to be worth it. Helper threads
+    // are started the first time they are needed and kept for later calls.
+    std::uint64_t Hash(unsigned ThreadCount = 1) {
+        const std::size_t ChunkCount = Pool.ChunkCount();
+        CachedVersions.resize(ChunkCount, NeverHashed);
+        ChunkHashes.resize(ChunkCount, 0);
+
+        Stale.clear();
+        for (std::size_t ChunkIndex = 0; ChunkIndex < ChunkCount; ++ChunkIndex) {
+            const std::uint64_t Version = Pool.ChunkVersion(ChunkIndex);
+            if (Version != CachedVersions[ChunkIndex] || Version == Pool.Version()) {
+                CachedVersions[ChunkIndex] = Version;
+                Stale.push_back(static_cast<std::uint32_t>(ChunkIndex));
+            }
+        }
+
+        const std::size_t WorkerCount = ThreadCount > 1 && Stale.size() >= ChunksPerThread * 2
+            ? std::min<std::size_t>(ThreadCount, Stale.size() / ChunksPerThread) : 1;
+        if (WorkerCount == 1) {
+            HashRange(0, Stale.size());
+        } else {
+            while (Helpers.size() < WorkerCount - 1) {
+                Helpers.emplace_back([this, Worker = Helpers.size() + 1] { HelperMain(Worker); });
+            }
+            {
+                std::lock_guard<std::mutex> Lock(Mutex);
+                Stride = (Stale.size() + WorkerCount - 1) / WorkerCount;
+                ActiveWorkers = WorkerCount;
+                Pending = WorkerCount - 1;
+                ++Generation;
+            }
+            Wake.notify_all();
+            HashRange(0, Stride);
+            std::unique_lock<std::mutex> Lock(Mutex);
+            Done.wait(Lock, [this] { return Pending == 0; });
+        }
+
+        StateHasher Combined(Seed, Kernels);
+        Combined.AppendValue(static_cast<std::uint64_t>(Pool.Size()));
+        for (std::size_t ChunkIndex = 0; ChunkIndex < ChunkCount; ++ChunkIndex) {
+            if (Pool.ChunkSize(ChunkIndex) > 0) Combined.AppendValue(ChunkHashes[ChunkIndex]);
+        }
+        return Combined.Finish();
+    }
+
+    std::uint64_t ChunkHash(std::size_t ChunkIndex) const { return ChunkHashes[ChunkIndex]; }
+
+private:
+    static constexpr std::uint64_t NeverHashed = ~std::uint64_t(0);
+    static constexpr std::size_t ChunksPerThread = 16;
+
+    // Helper Worker hashes its share of every parallel Hash() it takes part in.
+    void HelperMain(std::size_t Worker) {
+        std::uint64_t Seen = 0;
+        std::unique_lock<std::mutex> Lock(Mutex);
+        for (;;) {
+            Wake.wait(Lock, [this, &Seen] { return Stopping || Generation != Seen; });
+            if (Stopping) return;
+            Seen = Generation;
+            if (Worker >= ActiveWorkers) continue;
+            const std::size_t Begin = std::min(Stale.size(), Worker * Stride), End = std::min(Stale.size(), (Worker + 1) * Stride);
+            Lock.unlock();
+            HashRange(Begin, End);
+            Lock.lock();
+            if (--Pending == 0) Done.notify_one();
+        }
+    }
+
+    void HashRange(std::size_t Begin, std::size_t End) {
+        for (std::size_t Entry = Begin; Entry < End; ++Entry) {
+            const std::uint32_t ChunkIndex = Stale[Entry];
+            ChunkHashes[ChunkIndex] = HashChunk(ChunkIndex, std::make_index_sequence<TPool::AttributeCount>{});
+        }
+    }
+
+    template <std::size_t... I>
+    std::uint64_t HashChunk(std::uint32_t ChunkIndex, std::index_sequence<I...>) const {
+        const typename TPool::Chunk& Source = Pool.GetChunk(ChunkIndex);
+        StateHasher Hasher(Seed + ChunkIndex, Kernels);
+        Hasher.AppendValue(Source.Size());
+        (HashColumn(Hasher, Source.template Column<I>(), Source.Size()), ...);
+        return Hasher.Finish();
+    }
+
+    const TPool& Pool;
+    std::uint64_t Seed;
+    const HashKernelTable& Kernels;
+    std::vector<std::uint64_t> CachedVersions;
+    std::vector<std::uint64_t> ChunkHashes;
+    std::vector<std::uint32_t> Stale;
+
+    // Helper threads. The parallel Hash() in flight is Generation; helpers
+    // below ActiveWorkers take part, and Pending counts those not done yet.
+    std::vector<std::thread> Helpers;
+    std::mutex Mutex;
+    std::condition_variable Wake, Done;
+    std::uint64_t Generation = 0;
+    std::size_t ActiveWorkers = 0, Stride = 0, Pending = 0;
+    bool Stopping = false;
+};
+
+
+// --- EXAMPLE USAGE ---
+#ifdef WORLD_HASH_ENABLE_EXAMPLES
+
+#include <chrono>
+
+struct Transform : public Attribute {
+    float X = 0.0f, Y = 0.0f, Z = 0.0f;
+};
+struct Category : public Attribute {
+    std::string Name = "Default";
+};
+inline void HashValue(StateHasher& Hasher, const Category& Value) { HashValue(Hasher, Value.Name); }
+
+class Prop : public Composition<Prop, TypeList<>, TypeList<Transform, Category>> {};
+
+using PropPool = CompositionPool<Prop>;
+
+void Populate(PropPool& Pool) {
+    for (std::size_t Index = 0; Index < 100000; ++Index) {
+        Pool.Spawn(Transform{{}, float(Index), 1.0f, 2.0f}, Category{{}, Index % 7 ? "Rock" : "Tree"});
+    }
+}
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    using Micro = std::chrono::microseconds;
+
+    PropPool Local, Remote;
+    Populate(Local);
+    Populate(Remote);
+    WorldStateHasher<PropPool> LocalHasher(Local), RemoteHasher(Remote);
+
+    const auto ColdStart = Clock::now();
+    const std::uint64_t LocalHash = LocalHasher.Hash(4);
+    const auto ColdTime = Clock::now() - ColdStart;
+    std::cout << "Peers agree: " << (LocalHash == RemoteHasher.Hash(1) ? "yes" : "no")
+              << " (cold hash " << std::chrono::duration_cast<Micro>(ColdTime).count() << " us)\n";
+
+    // A frame that touches a handful of chunks on each peer, one of which diverges.
+    Local.AdvanceVersion();
+    Remote.AdvanceVersion();
+    for (std::size_t Index = 0; Index < 1000; ++Index) {
+        Local.Attribute<Transform>(Index * 50).X += 1.0f;
+        Remote.Attribute<Transform>(Index * 50).X += Index == 999 ? 2.0f : 1.0f;
+    }
+    Local.AdvanceVersion();
+    Remote.AdvanceVersion();
+
+    const auto WarmStart = Clock::now();
+    const std::uint64_t NextLocalHash = LocalHasher.Hash(4);
+    const auto WarmTime = Clock::now() - WarmStart;
+    std::cout << "Desync detected: " << (NextLocalHash != RemoteHasher.Hash(2) ? "yes" : "no")
+              << " (incremental hash " << std::chrono::duration_cast<Micro>(WarmTime).count() << " us)\n";
+
+    // Every kernel set gives the same hash, and so does a pool whose last
+    // chunk was emptied by despawns.
+    PropPool Scalar;
+    Populate(Scalar);
+    WorldStateHasher<PropPool> ScalarHasher(Scalar, 0, HashKernelsFor(SimdLevel::Scalar));
+    const std::size_t Extra = PropPool::Capacity - Scalar.Size() % PropPool::Capacity + 1;
+    for (std::size_t Index = 0; Index < Extra; ++Index) Scalar.Spawn(Transform{}, Category{});
+    for (std::size_t Index = 0; Index < Extra; ++Index) Scalar.Despawn(Scalar.Size() - 1);
+    WorldStateHasher<PropPool> FreshHasher(Remote);
+    Remote.Attribute<Transform>(999 * 50).X -= 1.0f;
+    for (std::size_t Index = 0; Index < 1000; ++Index) Remote.Attribute<Transform>(Index * 50).X -= 1.0f;
+    WorldStateHasher<PropPool> Sse2Hasher(Remote, 0, HashKernelsFor(SimdLevel::SSE2));
+    const std::uint64_t Expected = FreshHasher.Hash(4);
+    std::cout << "Scalar kernels with an empty trailing chunk, SSE2 and " << SimdLevelName(HashKernels().Level) << " agree: "
+              << (ScalarHasher.Hash(1) == Expected && Sse2Hasher.Hash(1) == Expected ? "yes" : "no") << std::endl;
+    return 0;
+}
+
+#endif // WORLD_HASH_ENABLE_EXAMPLES
+
+#endif // WORLD_STATE_HASH_CPP